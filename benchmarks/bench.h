@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include "perf_counters.h"
+
+namespace Bench {
+
+    using clock      = std::chrono::steady_clock;
+    using time_point = clock::time_point;
+
+    //---------------------------------
+    template <typename T>
+    inline uint64_t
+    getTime(T time) {
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+    }
+
+    //---------------------------------
+    // Returns the best time (ns) of several runs of func
+    template <typename Func>
+    inline uint64_t
+    measure(Func &&func, int runs = 5) {
+        uint64_t best = UINT64_MAX;
+        for (int i = 0; i < runs; ++i) {
+            time_point start = clock::now();
+            func();
+            uint64_t   time  = getTime(clock::now() - start);
+            if (time < best)
+                best = time;
+        }
+        return best;
+    }
+
+    //---------------------------------
+    struct Result {
+        uint64_t                ns;
+        PerfCounters::Values    counters;   // Of the best run
+    };
+
+    struct NoSetup {
+        void operator()() const {}
+    };
+
+    //---------------------------------
+    // The hardware counters of measureCounters, opened on the first call.
+    // Call it at the start of main, before any TVector parallel or async call, so that the
+    // worker pool threads are created after the counters are opened and are counted (see PerfCounters).
+    inline PerfCounters &
+    counters() {
+        static PerfCounters counters;
+        return counters;
+    }
+
+    //---------------------------------
+    // Same as measure, but it also reads the hardware counters (when available).
+    // setup runs before every run and it is not measured.
+    template <typename Func, typename Setup = NoSetup>
+    inline Result
+    measureCounters(Func &&func, int runs = 5, Setup &&setup = Setup {}) {
+        PerfCounters &perf = counters();
+
+        Result best { UINT64_MAX, {} };
+        for (int i = 0; i < runs; ++i) {
+            setup();
+
+            perf.start();
+            time_point start  = clock::now();
+            func();
+            uint64_t   time   = getTime(clock::now() - start);
+            auto       values = perf.stop();
+
+            if (time < best.ns)
+                best = Result { time, values };
+        }
+        return best;
+    }
+
+    //---------------------------------
+    inline void
+    printHeader() {
+        printf("%-32s %10s %10s %12s %8s %14s %14s %14s\n",
+               "operation", "ms", "ns/elem", "cycles/elem", "IPC", "cache-miss/el", "branch-miss/el", "dTLB-miss/el");
+    }
+
+    //---------------------------------
+    // Prints the time and the counters per element ("n/a" for the counters that are not available)
+    inline void
+    print(const char *name, size_t elements, const Result &result) {
+        const auto &c = result.counters;
+        double     n  = double(elements > 0 ? elements : 1);
+        char       rates[4][32];
+
+        auto rate = [&](char *out, PerfCounters::Counter counter) {
+            if (c.valid[counter])
+                snprintf(out, 32, "%.4f", c.value[counter] / n);
+            else
+                snprintf(out, 32, "n/a");
+        };
+
+        rate(rates[0], PerfCounters::Cycles);
+        rate(rates[1], PerfCounters::CacheMisses);
+        rate(rates[2], PerfCounters::BranchMisses);
+        rate(rates[3], PerfCounters::DTLBMisses);
+
+        char ipc[32] = "n/a";
+        if (c.valid[PerfCounters::Cycles] && c.valid[PerfCounters::Instructions] && c.value[PerfCounters::Cycles] > 0)
+            snprintf(ipc, sizeof(ipc), "%.2f", double(c.value[PerfCounters::Instructions]) / c.value[PerfCounters::Cycles]);
+
+        printf("%-32s %10.3f %10.3f %12s %8s %14s %14s %14s\n",
+               name, result.ns / 1e6, result.ns / n, rates[0], ipc, rates[1], rates[2], rates[3]);
+    }
+
+} // end of namespace
@@ -0,0 +1,237 @@
+#include "bench.h"
+#include <TVector.h>
+#include <bloom_TVector.h>
+#include <unordered_map>
+
+using namespace MindShake;
+
+//-------------------------------------
+int
+main(int argc, char *argv[]) {
+    size_t size = (argc > 1) ? size_t(atoll(argv[1])) : size_t(10 * 1000 * 1000);
+
+    // Opened before the worker pools start (see Bench::counters)
+    if (Bench::counters().available() == false)
+        printf("Hardware counters not available (container, VM or perf_event_paranoid). Showing times only.\n");
+
+    TVector<int> values(size);
+    std::iota(values.begin(), values.end(), 0);
+    values.shuffle(Xoshiro256(42));
+
+    TVector<int> sorted = values;
+    sorted.sort();
+
+    TVector<int> work;
+    auto         reset = [&]() { work = values; };
+
+    TVector<int> queries = values.sample(std::min<size_t>(size, 1000000), Xoshiro256(7));
+
+    printf("TVector<int> of %zu elements (best of 5)\n", size);
+    Bench::printHeader();
+
+    Bench::print("find (missing)", size, Bench::measureCounters([&]() {
+        volatile bool found = values.find(-1) != values.end();
+        (void) found;
+    }));
+
+    // Negative lookups: a scan vs the Bloom filter of TBloomVector
+    TBloomVector<int> bloomValues(values);
+    Bench::print("TBloomVector contains (missing)", 1000, Bench::measureCounters([&]() {
+        size_t found = 0;
+        for (int i = 1; i <= 1000; ++i)
+            found += bloomValues.contains(-i);
+        volatile size_t n = found;
+        (void) n;
+    }));
+
+    Bench::print("count", size, Bench::measureCounters([&]() {
+        volatile size_t n = values.count(7);
+        (void) n;
+    }));
+
+    Bench::print("sort", size, Bench::measureCounters([&]() { work.sort(); }, 5, reset));
+    Bench::print("sort_async + get", size, Bench::measureCounters([&]() { work.sort_async().get(); }, 5, reset));
+    Bench::print("sort (sorted input)", size, Bench::measureCounters([&]() { sorted.sort(); }));
+    Bench::print("stable_sort", size, Bench::measureCounters([&]() { work.stable_sort(); }, 5, reset));
+
+    // Sorting by a computed float key: the comparator computes 2 keys per comparison, sort_by one per element
+    struct Point { float x, y, z; };
+    TVector<Point> points(size), pointsWork;
+    Xoshiro256     g(3);
+    for (auto &p : points)
+        p = Point { float(g() >> 40), float(g() >> 40), float(g() >> 40) };
+    auto distance   = [](const Point &p) { return std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z); };
+    auto resetPoint = [&]() { pointsWork = points; };
+
+    Bench::print("sort(less) by distance", size, Bench::measureCounters([&]() {
+        pointsWork.sort([&](const Point &a, const Point &b) { return distance(a) < distance(b); });
+    }, 5, resetPoint));
+    Bench::print("sort_by distance", size, Bench::measureCounters([&]() { pointsWork.sort_by(distance); }, 5, resetPoint));
+    Bench::print("stable_sort_by distance", size, Bench::measureCounters([&]() { pointsWork.stable_sort_by(distance); }, 5, resetPoint));
+    Bench::print("sort_by int (radix)", size, Bench::measureCounters([&]() { work.sort_by([](const int &v) { return v; }); }, 5, reset));
+
+    // The 100 largest: full sort vs bounded heap
+    Bench::print("sort + first 100", size, Bench::measureCounters([&]() { work.sort(std::greater<int>()); }, 5, reset));
+    Bench::print("partial_sort(100)", size, Bench::measureCounters([&]() { work.partial_sort(100, std::greater<int>()); }, 5, reset));
+    Bench::print("top_k(100)", size, Bench::measureCounters([&]() { volatile size_t n = values.top_k(100).size(); (void) n; }));
+    Bench::print("top_k(par, 100)", size, Bench::measureCounters([&]() { volatile size_t n = values.top_k(ExecutionPolicy::par, 100).size(); (void) n; }));
+    Bench::print("median", size, Bench::measureCounters([&]() { volatile int m = values.median(); (void) m; }));
+
+    // Sorting parallel arrays: one argsort and one in place permutation per array
+    TVector<uint32_t> order;
+    Bench::print("argsort<uint32_t> int (radix)", size, Bench::measureCounters([&]() { order = values.argsort<uint32_t>(); }));
+    Bench::print("argsort<uint32_t>(less) int", size, Bench::measureCounters([&]() {
+        order = values.argsort<uint32_t>([](const int &a, const int &b) { return a < b; });
+    }));
+    Bench::print("apply_permutation", size, Bench::measureCounters([&]() { work.apply_permutation(order); }, 5, reset));
+
+    // Intersection of a short sorted list with a long one: linear merge vs galloping
+    TVector<int> shortList = values.sample(std::min<size_t>(size, 100), Xoshiro256(9)).sort();
+    Bench::print("std::set_intersection 100 x n", size, Bench::measureCounters([&]() {
+        TVector<int> out;
+        std::set_intersection(shortList.begin(), shortList.end(), sorted.begin(), sorted.end(), std::back_inserter(out));
+        volatile size_t n = out.size();
+        (void) n;
+    }));
+    Bench::print("set_intersection 100 x n", size, Bench::measureCounters([&]() { volatile size_t n = shortList.set_intersection(sorted).size(); (void) n; }));
+    Bench::print("intersect_count 100 x n", size, Bench::measureCounters([&]() { volatile size_t n = sorted.intersect_count(shortList); (void) n; }));
+    Bench::print("set_intersection n x n", size, Bench::measureCounters([&]() { volatile size_t n = sorted.set_intersection(sorted).size(); (void) n; }));
+
+    // Merging 256 sorted shards: repeated pairwise std::merge vs one k-way merge
+    std::vector<TVector<int>> shards(256);
+    for (size_t i = 0; i < size; ++i)
+        shards[i % shards.size()].push_back(values[i]);
+    for (auto &shard : shards)
+        shard.sort();
+
+    Bench::print("pairwise std::merge 256 runs", size, Bench::measureCounters([&]() {
+        std::vector<TVector<int>> level = shards;
+        while (level.size() > 1) {
+            std::vector<TVector<int>> next;
+            for (size_t i = 0; i + 1 < level.size(); i += 2) {
+                TVector<int> out(level[i].size() + level[i + 1].size());
+                std::merge(level[i].begin(), level[i].end(), level[i + 1].begin(), level[i + 1].end(), out.begin());
+                next.push_back(std::move(out));
+            }
+            if (level.size() % 2)
+                next.push_back(std::move(level.back()));
+            level.swap(next);
+        }
+    }));
+    Bench::print("merge_sorted 256 runs", size, Bench::measureCounters([&]() { volatile size_t n = TVector<int>::merge_sorted(shards).size(); (void) n; }));
+    Bench::print("merge_sorted(par) 256 runs", size, Bench::measureCounters([&]() { volatile size_t n = TVector<int>::merge_sorted(ExecutionPolicy::par, shards).size(); (void) n; }));
+
+    Bench::print("binary_search (per query)", queries.size(), Bench::measureCounters([&]() {
+        size_t found = 0;
+        for (int q : queries)
+            found += sorted.binary_search(q);
+        volatile size_t n = found;
+        (void) n;
+    }));
+
+    // Read-mostly lookups: std::lower_bound vs the implicit B+ tree index
+    auto searchIndex = sorted.build_search_index();
+    Bench::print("std::lower_bound (per query)", queries.size(), Bench::measureCounters([&]() {
+        size_t sum = 0;
+        for (int q : queries)
+            sum += size_t(std::lower_bound(sorted.begin(), sorted.end(), q) - sorted.begin());
+        volatile size_t n = sum;
+        (void) n;
+    }));
+    Bench::print("TVector::lower_bound (per query)", queries.size(), Bench::measureCounters([&]() {
+        size_t sum = 0;
+        for (int q : queries)
+            sum += size_t(sorted.lower_bound(q) - sorted.begin());
+        volatile size_t n = sum;
+        (void) n;
+    }));
+    Bench::print("search index lower_bound", queries.size(), Bench::measureCounters([&]() {
+        size_t sum = 0;
+        for (int q : queries)
+            sum += searchIndex.lower_bound(q);
+        volatile size_t n = sum;
+        (void) n;
+    }));
+
+    std::vector<size_t> positions(queries.size());
+    Bench::print("search index lower_bound_many", queries.size(), Bench::measureCounters([&]() {
+        searchIndex.lower_bound_many(queries, positions.data());
+        volatile size_t n = positions.back();
+        (void) n;
+    }));
+    Bench::print("lower_bound_many (per query)", queries.size(), Bench::measureCounters([&]() {
+        sorted.lower_bound_many(queries, positions.data());
+        volatile size_t n = positions.back();
+        (void) n;
+    }));
+
+    // Histogram of 10000 keys: std::unordered_map vs the open addressing table of count_by
+    auto bucket = [](const int &v) { return v % 10000; };
+    Bench::print("std::unordered_map histogram", size, Bench::measureCounters([&]() {
+        std::unordered_map<int, size_t> histogram;
+        for (int v : values)
+            ++histogram[bucket(v)];
+        volatile size_t n = histogram.size();
+        (void) n;
+    }));
+    Bench::print("count_by", size, Bench::measureCounters([&]() { volatile size_t n = values.count_by(bucket).size(); (void) n; }));
+    Bench::print("count_by(par)", size, Bench::measureCounters([&]() { volatile size_t n = values.count_by(ExecutionPolicy::par, bucket).size(); (void) n; }));
+    Bench::print("group_by", size, Bench::measureCounters([&]() { volatile size_t n = values.group_by(bucket).size(); (void) n; }));
+
+    Bench::print("reduce seq", size, Bench::measureCounters([&]() {
+        volatile int sum = values.reduce(ExecutionPolicy::seq, 0, [](int a, int b) { return a + b; });
+        (void) sum;
+    }));
+
+    Bench::print("reduce par", size, Bench::measureCounters([&]() {
+        volatile int sum = values.reduce(ExecutionPolicy::par, 0, [](int a, int b) { return a + b; });
+        (void) sum;
+    }));
+
+    // Irregular costs per element: the threads take chunks as they finish them
+    auto irregular = [](int &v) {
+        for (int i = (v & 63); i > 0; --i)
+            v = v * 31 + i;
+    };
+    Bench::print("for_each (irregular)", size, Bench::measureCounters([&]() { work.for_each(irregular); }, 5, reset));
+    Bench::print("for_each(par) (irregular)", size, Bench::measureCounters([&]() { work.for_each(ExecutionPolicy::par, irregular); }, 5, reset));
+    Bench::print("for_each_chunk(par) add", size, Bench::measureCounters([&]() {
+        work.for_each_chunk(ExecutionPolicy::par, [](int *first, int *last, size_t) {
+            for (; first != last; ++first)
+                *first += 3;
+        });
+    }, 5, reset));
+
+    // Splitting by a predicate: filter allocates, partition works in place
+    auto odd = [](const int &v) { return (v & 1) != 0; };
+    Bench::print("filter + filter", size, Bench::measureCounters([&]() {
+        volatile size_t n = values.filter(odd).size() + values.filter([&](const int &v) { return !odd(v); }).size();
+        (void) n;
+    }));
+    Bench::print("partition", size, Bench::measureCounters([&]() { work.partition(odd); }, 5, reset));
+    Bench::print("partition(par)", size, Bench::measureCounters([&]() { work.partition(ExecutionPolicy::par, odd); }, 5, reset));
+    Bench::print("stable_partition", size, Bench::measureCounters([&]() { work.stable_partition(odd); }, 5, reset));
+    Bench::print("stable_partition(par)", size, Bench::measureCounters([&]() { work.stable_partition(ExecutionPolicy::par, odd); }, 5, reset));
+
+    // Prefix sums: a left to right loop vs blocks of 4 (floats, with a policy) and the two pass parallel scan
+    TVector<float> reals(values.begin(), values.end()), realsWork;
+    auto           resetReals = [&]() { realsWork = reals; };
+    Bench::print("std::inclusive_scan float", size, Bench::measureCounters([&]() {
+        std::inclusive_scan(realsWork.begin(), realsWork.end(), realsWork.begin());
+    }, 5, resetReals));
+    Bench::print("inclusive_scan float", size, Bench::measureCounters([&]() { realsWork.inclusive_scan(); }, 5, resetReals));
+    Bench::print("inclusive_scan(unseq) float", size, Bench::measureCounters([&]() { realsWork.inclusive_scan(ExecutionPolicy::unseq); }, 5, resetReals));
+    Bench::print("inclusive_scan(par) float", size, Bench::measureCounters([&]() { realsWork.inclusive_scan(ExecutionPolicy::par); }, 5, resetReals));
+    Bench::print("exclusive_scan(par) int", size, Bench::measureCounters([&]() { work.exclusive_scan(ExecutionPolicy::par, 0); }, 5, reset));
+
+    // Cost of checking a cancellation token between units
+    TCancellationToken token;
+    Bench::print("reduce seq (cancellable)", size, Bench::measureCounters([&]() {
+        volatile int sum = values.reduce(ExecutionPolicy::seq, 0, [](int a, int b) { return a + b; }, token).value;
+        (void) sum;
+    }));
+
+    Bench::print("shuffle", size, Bench::measureCounters([&]() { work.shuffle(); }, 5, reset));
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "bench.h"
+#include <concurrent_TVector.h>
+#include <mutex>
+#include <thread>
+
+using namespace MindShake;
+
+//-------------------------------------
+template <typename Func>
+static void
+runThreads(int numThreads, Func &&func) {
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back(func, t);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+//-------------------------------------
+int
+main() {
+    const int total = 4 * 1024 * 1024;
+
+    printf("push_back of %d ints (best of 5, ms)\n", total);
+    printf("%8s %16s %16s %16s %16s\n", "threads", "mutex+TVector", "thread-local", "TConcurrentVector", "contiguous");
+
+    for (int numThreads = 1; numThreads <= 64; numThreads *= 2) {
+        const int perThread = total / numThreads;
+
+        // Shared TVector behind a mutex
+        uint64_t mutexTime = Bench::measure([&]() {
+            TVector<int> values;
+            std::mutex   mutex;
+            runThreads(numThreads, [&](int t) {
+                for (int i = 0; i < perThread; ++i) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    values.push_back(t * perThread + i);
+                }
+            });
+        });
+
+        // One TVector per thread merged at the end
+        uint64_t localTime = Bench::measure([&]() {
+            std::vector<TVector<int>> locals(numThreads);
+            runThreads(numThreads, [&](int t) {
+                for (int i = 0; i < perThread; ++i) {
+                    locals[t].push_back(t * perThread + i);
+                }
+            });
+
+            TVector<int> values;
+            values.reserve(total);
+            for (auto &local : locals) {
+                values.insert(values.end(), local.begin(), local.end());
+            }
+        });
+
+        // Lock-free append
+        uint64_t concurrentTime = Bench::measure([&]() {
+            TConcurrentVector<int> values;
+            runThreads(numThreads, [&](int t) {
+                for (int i = 0; i < perThread; ++i) {
+                    values.push_back(t * perThread + i);
+                }
+            });
+
+            TVector<int> frozen = values.freeze();
+        });
+
+        // Lock-free append to the buffer that freeze() hands off
+        uint64_t contiguousTime = Bench::measure([&]() {
+            TConcurrentVector<int> values(TConcurrentVector<int>::contiguous, total);
+            runThreads(numThreads, [&](int t) {
+                for (int i = 0; i < perThread; ++i) {
+                    values.push_back(t * perThread + i);
+                }
+            });
+
+            TVector<int> frozen = values.freeze();
+        });
+
+        printf("%8d %16.2f %16.2f %16.2f %16.2f\n", numThreads, mutexTime / 1e6, localTime / 1e6, concurrentTime / 1e6, contiguousTime / 1e6);
+    }
+
+    return 0;
+}
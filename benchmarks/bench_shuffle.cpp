@@ -0,0 +1,28 @@
+#include "bench.h"
+#include <TVector.h>
+
+using namespace MindShake;
+
+//-------------------------------------
+int
+main(int argc, char *argv[]) {
+    size_t size = (argc > 1) ? size_t(atoll(argv[1])) : size_t(50 * 1000 * 1000);
+
+    TVector<uint32_t> values(size);
+    std::iota(values.begin(), values.end(), 0);
+
+    printf("shuffle of %zu uint32 (best of 3, ms)\n", size);
+
+    uint64_t time = Bench::measure([&]() { values.shuffle(); }, 3);
+    printf("%-28s %10.2f\n", "shuffle()", time / 1e6);
+
+    time = Bench::measure([&]() { values.shuffle(ExecutionPolicy::seq, 42); }, 3);
+    printf("%-28s %10.2f\n", "shuffle(seq)", time / 1e6);
+
+    for (size_t numThreads = 1; numThreads <= 2 * detail::hardwareThreads(); numThreads *= 2) {
+        time = Bench::measure([&]() { values.shuffle(ExecutionPolicy::par, 42, numThreads); }, 3);
+        printf("shuffle(par, %2zu threads)     %10.2f\n", numThreads, time / 1e6);
+    }
+
+    return 0;
+}
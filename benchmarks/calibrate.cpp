@@ -0,0 +1,90 @@
+// Measures, in this host, from how many elements par is faster than seq for
+// transform, reduce and transform_reduce, and saves the result for ExecutionPolicy::automatic.
+//
+// Usage: tvector_calibrate [output file (tvector_thresholds.cfg)]
+// Then: export TVECTOR_THRESHOLDS=<output file>, or ExecutionThresholds::global().load(<output file>)
+#include "bench.h"
+#include <TVector.h>
+
+using namespace MindShake;
+
+static const size_t kMinSize = 1024;
+static const size_t kMaxSize = 32 * 1024 * 1024;
+
+//-------------------------------------
+// First size from which par is clearly faster (10%) than seq in that size and the next one
+template <typename Func>
+static size_t
+findCrossover(const char *name, Func &&run) {
+    size_t crossover = SIZE_MAX;
+    int    wins      = 0;
+
+    printf("%s\n", name);
+    for (size_t size = kMinSize; size <= kMaxSize; size *= 2) {
+        int      runs = (size < 1024 * 1024) ? 20 : 5;
+        uint64_t seq  = run(size, ExecutionPolicy::seq, runs);
+        uint64_t par  = run(size, ExecutionPolicy::par, runs);
+        printf("  %10zu elements: seq %10.3f ms  par %10.3f ms\n", size, seq / 1e6, par / 1e6);
+
+        if (double(par) < double(seq) * 0.9) {
+            if (++wins == 1)
+                crossover = size;
+            if (wins == 2)
+                break;
+        }
+        else {
+            wins      = 0;
+            crossover = SIZE_MAX;
+        }
+    }
+    if (wins < 2)
+        crossover = SIZE_MAX;   // A single win at kMaxSize
+
+    if (crossover == SIZE_MAX)
+        printf("  -> par never wins\n");
+    else
+        printf("  -> par from %zu elements\n", crossover);
+    return crossover;
+}
+
+//-------------------------------------
+int
+main(int argc, char *argv[]) {
+    const char *path = (argc > 1) ? argv[1] : "tvector_thresholds.cfg";
+
+    // Unsigned: the sums of up to kMaxSize values wrap instead of overflowing
+    TVector<uint32_t> values(kMaxSize), output(kMaxSize);
+    std::iota(values.begin(), values.end(), 0u);
+
+    printf("Hardware threads: %zu\n", detail::hardwareThreads());
+
+    ExecutionThresholds thresholds;
+    thresholds.transform = findCrossover("transform", [&](size_t size, ExecutionPolicy policy, int runs) {
+        TVector<uint32_t> input(values.begin(), values.begin() + size);
+        return Bench::measure([&]() { input.transform(policy, output.begin(), [](uint32_t v) { return v * 3 + 1; }); }, runs);
+    });
+
+    thresholds.reduce = findCrossover("reduce", [&](size_t size, ExecutionPolicy policy, int runs) {
+        TVector<uint32_t> input(values.begin(), values.begin() + size);
+        return Bench::measure([&]() {
+            volatile uint32_t sum = input.reduce(policy, 0u, [](uint32_t a, uint32_t b) { return a + b; });
+            (void) sum;
+        }, runs);
+    });
+
+    thresholds.transform_reduce = findCrossover("transform_reduce", [&](size_t size, ExecutionPolicy policy, int runs) {
+        TVector<uint32_t> input(values.begin(), values.begin() + size);
+        return Bench::measure([&]() {
+            volatile uint32_t sum = input.transform_reduce(policy, 0u, [](uint32_t a, uint32_t b) { return a + b; }, [](uint32_t v) { return v * 3 + 1; });
+            (void) sum;
+        }, runs);
+    });
+
+    if (thresholds.save(path) == false) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 1;
+    }
+
+    printf("Saved in %s\n", path);
+    return 0;
+}
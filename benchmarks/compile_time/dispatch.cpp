@@ -0,0 +1,44 @@
+// Translation unit with many TVector<T> instantiations of the policy-aware members.
+// Build it with -DUSE_TAGS to use the compile-time policies instead of the ExecutionPolicy enum.
+// See measure.sh
+#include <TVector.h>
+#include <cstdint>
+
+using namespace MindShake;
+
+#if defined(USE_TAGS)
+    #define POLICY  execution::par
+#else
+    #define POLICY  ExecutionPolicy::par
+#endif
+
+template <class T>
+double
+use(TVector<T> &values) {
+    TVector<T> output(values.size());
+    values.transform(POLICY, output.begin(), [](const T &v) { return T(v + 1); });
+    values.transform(POLICY, output.begin(), output.begin(), [](const T &a, const T &b) { return T(a * b); });
+    values.transform(POLICY, output, [](const T &v) { return T(v * 2); });
+
+    T      sum = values.reduce(POLICY, T(0), [](T a, T b) { return T(a + b); });
+    double avg = values.transform_reduce(POLICY, 0.0, std::plus<double>(), [](const T &v) { return double(v); });
+    return double(sum) + avg + double(output[0]);
+}
+
+#define USE(type)                       \
+    {                                   \
+        TVector<type> values(argc, 1);  \
+        total += use(values);           \
+    }
+
+int
+main(int argc, char *argv[]) {
+    (void) argv;
+    double total = 0;
+    USE(int8_t)   USE(uint8_t)   USE(int16_t)  USE(uint16_t)
+    USE(int32_t)  USE(uint32_t)  USE(int64_t)  USE(uint64_t)
+    USE(float)    USE(double)    USE(long double)
+    USE(char)     USE(wchar_t)   USE(char16_t) USE(char32_t)
+    USE(long)     USE(unsigned long)
+    return int(total) & 1;
+}
@@ -0,0 +1,34 @@
+// Translation unit using the common TVector members, to compare the cost of the headers.
+// Build it with -DUSE_CORE to include only core_TVector.h, and add -DTVECTOR_EXTERN_TEMPLATES
+// to use the explicit instantiations of TVectorInstances. See measure.sh
+// Only members defined in core_TVector.h are used, so every variant links.
+#if defined(USE_CORE)
+    #include <core_TVector.h>
+#else
+    #include <TVector.h>
+#endif
+
+using namespace MindShake;
+
+template <class T>
+T
+use(TVector<T> &values) {
+    values.push_back(T(1));
+    values.insert(0, T(2));
+    values.sort();
+    values.unique();
+    values.erase_quick(0);
+    TVector<T> odd = values.filter([](const T &v) { return int(v) & 1; });
+    return values.min() + values.max() + T(odd.size()) + values.reduce(T(0), [](T a, T b) { return T(a + b); });
+}
+
+int
+main(int argc, char *argv[]) {
+    (void) argv;
+    TVector<int>      ints(argc, 1);
+    TVector<float>    floats(argc, 1.0f);
+    TVector<double>   doubles(argc, 1.0);
+    TVector<uint8_t>  bytes(argc, 1);
+    TVector<int64_t>  longs(argc, 1);
+    return int(use(ints) + use(floats) + use(doubles) + use(bytes) + use(longs)) & 1;
+}
@@ -0,0 +1,31 @@
+#!/bin/sh
+# Compile time and object size of:
+#   - dispatch.cpp with the ExecutionPolicy enum and with the compile-time tags.
+#   - includes.cpp with TVector.h, with core_TVector.h and with core_TVector.h + TVECTOR_EXTERN_TEMPLATES.
+# Usage: measure.sh [compiler (c++)] [extra flags]
+CXX=${1:-c++}
+[ $# -gt 0 ] && shift
+DIR=$(cd "$(dirname "$0")" && pwd)
+OUT=${TMPDIR:-/tmp}/tvector_compile_time
+mkdir -p "$OUT"
+
+# measure <name> <source> [defines]
+measure() {
+    NAME=$1
+    SOURCE=$2
+    shift 2
+
+    START=$(date +%s.%N)
+    "$CXX" -std=c++17 -O2 "$@" $FLAGS -I"$DIR/../../src" -c "$DIR/$SOURCE" -o "$OUT/$NAME.o" || exit 1
+    END=$(date +%s.%N)
+
+    SIZE=$(size "$OUT/$NAME.o" | awk 'NR == 2 { print $1 }')
+    printf "%-12s  compile %6.2f s  text %9s bytes\n" "$NAME" "$(echo "$START $END" | awk "{ print \$2 - \$1 }")" "$SIZE"
+}
+
+FLAGS="$*"
+measure enum    dispatch.cpp
+measure tags    dispatch.cpp -DUSE_TAGS
+measure full    includes.cpp
+measure core    includes.cpp -DUSE_CORE
+measure extern  includes.cpp -DUSE_CORE -DTVECTOR_EXTERN_TEMPLATES
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace Bench {
+
+//-------------------------------------
+// Hardware performance counters through Linux perf_event_open (user space only).
+// Each counter is opened on its own, so a missing one (common in containers and VMs,
+// or with a restrictive /proc/sys/kernel/perf_event_paranoid) does not disable the others.
+// In other platforms, or when nothing can be opened, available() returns false.
+// The counters also count the threads created after they are opened (inherit), so parallel operations
+// include the work of their worker threads only when the counters are opened before the pools start:
+// the TVector WorkerPool (parallelFor and the async algorithms) and TBB are created on first use and
+// their threads live until exit. Open them before any TVector parallel or async call (see Bench::counters).
+//-------------------------------------
+class PerfCounters {
+public:
+    enum Counter {
+        Cycles,
+        Instructions,
+        CacheMisses,
+        BranchMisses,
+        DTLBMisses,
+        NumCounters
+    };
+
+    struct Values {
+        uint64_t    value[NumCounters];
+        bool        valid[NumCounters];
+    };
+
+public:
+    PerfCounters() {
+        for (int i = 0; i < NumCounters; ++i)
+            mFd[i] = -1;
+
+#if defined(__linux__)
+        const uint64_t dtlbReadMiss = PERF_COUNT_HW_CACHE_DTLB |
+                                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+        mFd[Cycles]       = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        mFd[Instructions] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        mFd[CacheMisses]  = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        mFd[BranchMisses] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        mFd[DTLBMisses]   = open(PERF_TYPE_HW_CACHE, dtlbReadMiss);
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int fd : mFd) {
+            if (fd >= 0)
+                close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters &)             = delete;
+    PerfCounters & operator=(const PerfCounters &) = delete;
+
+    bool available() const {
+        for (int fd : mFd) {
+            if (fd >= 0)
+                return true;
+        }
+        return false;
+    }
+
+    bool available(Counter counter) const                                   { return mFd[counter] >= 0;                                     }
+
+    void start() {
+#if defined(__linux__)
+        for (int fd : mFd) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    Values stop() {
+        Values values;
+        memset(&values, 0, sizeof(values));
+
+#if defined(__linux__)
+        for (int i = 0; i < NumCounters; ++i) {
+            if (mFd[i] >= 0)
+                ioctl(mFd[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+
+        for (int i = 0; i < NumCounters; ++i) {
+            // value, time enabled, time running (to scale when the kernel multiplexes counters)
+            uint64_t data[3] = {};
+            if (mFd[i] < 0 || ::read(mFd[i], data, sizeof(data)) != ssize_t(sizeof(data)) || data[2] == 0)
+                continue;
+
+            values.value[i] = (data[1] == data[2]) ? data[0] : uint64_t(double(data[0]) * double(data[1]) / double(data[2]));
+            values.valid[i] = true;
+        }
+#endif
+        return values;
+    }
+
+    static const char * name(Counter counter) {
+        static const char *names[NumCounters] = { "cycles", "instructions", "cache-misses", "branch-misses", "dTLB-misses" };
+        return names[counter];
+    }
+
+protected:
+#if defined(__linux__)
+    static int open(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = type;
+        attr.config         = config;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.inherit        = 1;    // Plus the threads created later (pools started after opening)
+        attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        return int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+protected:
+    int     mFd[NumCounters];
+};
+
+} // end of namespace
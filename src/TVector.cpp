@@ -0,0 +1,10 @@
+// Explicit instantiation of TVector for the common element types (see TVECTOR_COMMON_TYPES in core_TVector.h)
+#include "TVector.h"
+
+namespace MindShake {
+
+#define TVECTOR_INSTANTIATE(type)   template class TVector<type>;
+TVECTOR_COMMON_TYPES(TVECTOR_INSTANTIATE)
+#undef TVECTOR_INSTANTIATE
+
+} // end of namespace
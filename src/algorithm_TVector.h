@@ -0,0 +1,244 @@
+#pragma once
+
+//-------------------------------------
+// TVector members that run with an execution policy: transform, reduce, transform_reduce and argsort.
+// Declared in core_TVector.h. This is the only TVector header that includes <execution>.
+//-------------------------------------
+
+#include "core_TVector.h"
+#include "threads_TVector.h"
+#include "sort_TVector.h"    // argsort(policy) falls back to argsort
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    #include <execution>
+#endif
+
+namespace MindShake {
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+namespace detail {
+
+    //---------------------------------
+    // std::execution object of a tag (automatic must be resolved before)
+    inline const auto & stdPolicy(execution::seq_t)                        { return std::execution::seq;                                   }
+    inline const auto & stdPolicy(execution::par_t)                        { return std::execution::par;                                   }
+    inline const auto & stdPolicy(execution::par_unseq_t)                  { return std::execution::par_unseq;                             }
+    #if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+    inline const auto & stdPolicy(execution::unseq_t)                      { return std::execution::unseq;                                 }
+    #else
+    inline const auto & stdPolicy(execution::unseq_t)                      { return std::execution::seq;                                   }   // unseq is C++20
+    #endif
+
+} // end of namespace detail
+#endif
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Output, class UnaryOperation>
+TVector<T, Allocator> &
+TVector<T, Allocator>::transform(ExecutionPolicy policy, Output firstOutput, UnaryOperation op, double relativeCost) {
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    switch (resolvePolicy(policy, PolicyOperation::transform, size(), relativeCost)) {
+        case ExecutionPolicy::par:       return transform(execution::par, firstOutput, op);
+        case ExecutionPolicy::par_unseq: return transform(execution::par_unseq, firstOutput, op);
+        case ExecutionPolicy::unseq:     return transform(execution::unseq, firstOutput, op);
+        default:                         return transform(execution::seq, firstOutput, op);
+    }
+#else
+    return transform(firstOutput, op);
+#endif
+}
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+//-------------------------------------
+template <class T, class Allocator>
+template <ExecutionPolicy Policy, class Output, class UnaryOperation>
+TVector<T, Allocator> &
+TVector<T, Allocator>::transform(execution::policy_tag<Policy> policy, Output firstOutput, UnaryOperation op) {
+    if constexpr (Policy == ExecutionPolicy::automatic) {
+        if (resolvePolicy(Policy, PolicyOperation::transform, size()) == ExecutionPolicy::par)
+            return transform(execution::par, firstOutput, op);
+        return transform(execution::seq, firstOutput, op);
+    }
+    else {
+        TVECTOR_TRACE_SCOPE("transform", size(), Policy);
+        std::transform(detail::stdPolicy(policy), cbegin(), cend(), firstOutput, op);
+        return *this;
+    }
+}
+#endif
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Input, class Output, class BinaryOperation, class>
+TVector<T, Allocator> &
+TVector<T, Allocator>::transform(ExecutionPolicy policy, Input firstInput, Output firstOutput, BinaryOperation op, double relativeCost) {
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    switch (resolvePolicy(policy, PolicyOperation::transform, size(), relativeCost)) {
+        case ExecutionPolicy::par:       return transform(execution::par, firstInput, firstOutput, op);
+        case ExecutionPolicy::par_unseq: return transform(execution::par_unseq, firstInput, firstOutput, op);
+        case ExecutionPolicy::unseq:     return transform(execution::unseq, firstInput, firstOutput, op);
+        default:                         return transform(execution::seq, firstInput, firstOutput, op);
+    }
+#else
+    return transform(firstInput, firstOutput, op);
+#endif
+}
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+//-------------------------------------
+template <class T, class Allocator>
+template <ExecutionPolicy Policy, class Input, class Output, class BinaryOperation>
+TVector<T, Allocator> &
+TVector<T, Allocator>::transform(execution::policy_tag<Policy> policy, Input firstInput, Output firstOutput, BinaryOperation op) {
+    if constexpr (Policy == ExecutionPolicy::automatic) {
+        if (resolvePolicy(Policy, PolicyOperation::transform, size()) == ExecutionPolicy::par)
+            return transform(execution::par, firstInput, firstOutput, op);
+        return transform(execution::seq, firstInput, firstOutput, op);
+    }
+    else {
+        TVECTOR_TRACE_SCOPE("transform", size(), Policy);
+        std::transform(detail::stdPolicy(policy), cbegin(), cend(), firstInput, firstOutput, op);
+        return *this;
+    }
+}
+#endif
+
+//-------------------------------------
+template <class T, class Allocator>
+template <template <typename...> class OutputClass, typename... Args, class UnaryOperation>
+TVector<T, Allocator> &
+TVector<T, Allocator>::transform(ExecutionPolicy policy, OutputClass<Args...> &output, UnaryOperation op, double relativeCost) {
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    switch (resolvePolicy(policy, PolicyOperation::transform, size(), relativeCost)) {
+        case ExecutionPolicy::par:       return transform(execution::par, output, op);
+        case ExecutionPolicy::par_unseq: return transform(execution::par_unseq, output, op);
+        case ExecutionPolicy::unseq:     return transform(execution::unseq, output, op);
+        default:                         return transform(execution::seq, output, op);
+    }
+#else
+    return transform(output, op);
+#endif
+}
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+//-------------------------------------
+template <class T, class Allocator>
+template <ExecutionPolicy Policy, template <typename...> class OutputClass, typename... Args, class UnaryOperation, class>
+TVector<T, Allocator> &
+TVector<T, Allocator>::transform(execution::policy_tag<Policy> policy, OutputClass<Args...> &output, UnaryOperation op) {
+    if constexpr (Policy == ExecutionPolicy::automatic) {
+        if (resolvePolicy(Policy, PolicyOperation::transform, size()) == ExecutionPolicy::par)
+            return transform(execution::par, output, op);
+        return transform(execution::seq, output, op);
+    }
+    else {
+        TVECTOR_TRACE_SCOPE("transform", size(), Policy);
+        if (output.size() < size())
+            output.resize(size());
+
+        std::transform(detail::stdPolicy(policy), cbegin(), cend(), output.begin(), op);
+        return *this;
+    }
+}
+#endif
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class U, class BinaryOperation>
+U
+TVector<T, Allocator>::reduce(ExecutionPolicy policy, U init, BinaryOperation op, double relativeCost) const {
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    switch (resolvePolicy(policy, PolicyOperation::reduce, size(), relativeCost)) {
+        case ExecutionPolicy::par:       return reduce(execution::par, init, op);
+        case ExecutionPolicy::par_unseq: return reduce(execution::par_unseq, init, op);
+        case ExecutionPolicy::unseq:     return reduce(execution::unseq, init, op);
+        default:                         return reduce(execution::seq, init, op);
+    }
+#else
+    return std::accumulate(cbegin(), cend(), init, op);
+#endif
+}
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+//-------------------------------------
+template <class T, class Allocator>
+template <ExecutionPolicy Policy, class U, class BinaryOperation>
+U
+TVector<T, Allocator>::reduce(execution::policy_tag<Policy> policy, U init, BinaryOperation op) const {
+    if constexpr (Policy == ExecutionPolicy::automatic) {
+        if (resolvePolicy(Policy, PolicyOperation::reduce, size()) == ExecutionPolicy::par)
+            return reduce(execution::par, init, op);
+        return reduce(execution::seq, init, op);
+    }
+    else {
+        TVECTOR_TRACE_SCOPE("reduce", size(), Policy);
+        return std::reduce(detail::stdPolicy(policy), cbegin(), cend(), init, op);
+    }
+}
+#endif
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class U, class BinaryReductionOp, class UnaryTransformOp>
+U
+TVector<T, Allocator>::transform_reduce(ExecutionPolicy policy, U init, BinaryReductionOp reduce, UnaryTransformOp transform, double relativeCost) const {
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    switch (resolvePolicy(policy, PolicyOperation::transform_reduce, size(), relativeCost)) {
+        case ExecutionPolicy::par:       return transform_reduce(execution::par, init, reduce, transform);
+        case ExecutionPolicy::par_unseq: return transform_reduce(execution::par_unseq, init, reduce, transform);
+        case ExecutionPolicy::unseq:     return transform_reduce(execution::unseq, init, reduce, transform);
+        default:                         return transform_reduce(execution::seq, init, reduce, transform);
+    }
+#else
+    return std::accumulate(cbegin(), cend(), init, [&](const auto &acc, const auto &val) {
+        return reduce(acc, transform(val));
+    });
+#endif
+}
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+//-------------------------------------
+template <class T, class Allocator>
+template <ExecutionPolicy Policy, class U, class BinaryReductionOp, class UnaryTransformOp>
+U
+TVector<T, Allocator>::transform_reduce(execution::policy_tag<Policy> policy, U init, BinaryReductionOp reduce, UnaryTransformOp transform) const {
+    if constexpr (Policy == ExecutionPolicy::automatic) {
+        if (resolvePolicy(Policy, PolicyOperation::transform_reduce, size()) == ExecutionPolicy::par)
+            return transform_reduce(execution::par, init, reduce, transform);
+        return transform_reduce(execution::seq, init, reduce, transform);
+    }
+    else {
+        TVECTOR_TRACE_SCOPE("transform_reduce", size(), Policy);
+        return std::transform_reduce(detail::stdPolicy(policy), cbegin(), cend(), init, reduce, transform);
+    }
+}
+#endif
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Index, class Less>
+TVector<Index>
+TVector<T, Allocator>::argsort(ExecutionPolicy policy, Less less) const {
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    ExecutionPolicy resolved = resolvePolicy(policy, PolicyOperation::transform, size(), detail::log2Cost(size()));
+    if (resolved != ExecutionPolicy::par && resolved != ExecutionPolicy::par_unseq)
+        return argsort<Index>(less);
+
+    TVECTOR_TRACE_SCOPE("argsort", size(), resolved);
+    TVector<Index> order(size());
+    std::iota(order.begin(), order.end(), Index(0));
+
+    const T *values = data();
+    auto    byValue = [values, &less](Index a, Index b) { return less(values[a], values[b]); };
+    if (resolved == ExecutionPolicy::par)
+        std::stable_sort(std::execution::par, order.begin(), order.end(), byValue);
+    else
+        std::stable_sort(std::execution::par_unseq, order.begin(), order.end(), byValue);
+    return order;
+#else
+    return argsort<Index>(less);
+#endif
+}
+
+} // end of namespace
@@ -0,0 +1,218 @@
+#pragma once
+
+//-------------------------------------
+// Asynchronous TVector algorithms (declared in core_TVector.h): sort_async, transform_async, reduce_async and
+// filter_async run on a pool of worker threads and return a TAsync: a std::future that can also call back
+// when it is ready (on_ready) and, with C++20 coroutines, be co_awaited.
+//-------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include "core_TVector.h"
+#include "threads_TVector.h"
+#include "parallel_TVector.h"   // sort_async sorts in parallel
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+    #if __has_include(<coroutine>)
+        #include <coroutine>
+        #define TVECTOR_COROUTINES  1
+    #endif
+#endif
+
+namespace MindShake {
+
+namespace detail {
+
+    //---------------------------------
+    // Completion of an asynchronous task and the callback waiting for it
+    class AsyncState {
+    public:
+        // false when it was already complete (and callback was not stored)
+        bool setCallback(std::function<void()> callback) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mDone)
+                return false;
+            mCallback = std::move(callback);
+            return true;
+        }
+
+        void complete() {
+            std::function<void()> callback;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mDone = true;
+                callback.swap(mCallback);
+            }
+            if (callback)
+                callback();
+        }
+
+    protected:
+        std::mutex              mMutex;
+        std::function<void()>   mCallback;
+        bool                    mDone = false;
+    };
+
+} // end of namespace detail
+
+//-------------------------------------
+// Handle of an asynchronous TVector algorithm: a std::future (get, wait, ready) plus
+// - on_ready(callback): callback() runs once the result is ready, on the worker thread (or right away on
+//   the calling thread when it already is). Only one callback.
+// - co_await (C++20): the coroutine is resumed on the worker thread that finished the task.
+// Destroying it neither waits for the task nor cancels it.
+//-------------------------------------
+template <class R>
+class TAsync {
+public:
+    TAsync() = default;
+    TAsync(std::future<R> future, std::shared_ptr<detail::AsyncState> state)
+        : mFuture(std::move(future)), mState(std::move(state)) { }
+
+    R           get()                                                       { return mFuture.get();                                         }
+    void        wait() const                                                { mFuture.wait();                                               }
+    bool        valid() const                                               { return mFuture.valid();                                       }
+    bool        ready() const                                               { return mFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+    std::future<R> & future()                                               { return mFuture;                                               }
+
+    void on_ready(std::function<void()> callback) {
+        if (mState->setCallback(callback) == false)
+            callback();
+    }
+
+#if defined(TVECTOR_COROUTINES)
+    bool        await_ready() const                                         { return ready();                                               }
+    bool        await_suspend(std::coroutine_handle<> handle)               { return mState->setCallback([handle]() { handle.resume(); }); }
+    R           await_resume()                                              { return get();                                                 }
+#endif
+
+protected:
+    std::future<R>                      mFuture;
+    std::shared_ptr<detail::AsyncState> mState;
+};
+
+namespace detail {
+
+    //---------------------------------
+    // sort_async: the parallel sort of parallel_TVector.h when automatic picks par (with its cost per element)
+    template <class Vector, class Less>
+    inline void
+    sortAsync(Vector &items, Less &less) {
+        if (resolvePolicy(ExecutionPolicy::automatic, PolicyOperation::transform, items.size(), 8.0) == ExecutionPolicy::par)
+            items.sort(ExecutionPolicy::par, less, TCancellationToken());
+        else
+            std::sort(items.begin(), items.end(), less);
+    }
+
+    //---------------------------------
+    // Runs func() on the WorkerPool
+    template <class R, class Func>
+    inline TAsync<R>
+    runAsync(Func &&func) {
+        auto task  = std::make_shared<std::packaged_task<R()>>(std::forward<Func>(func));
+        auto state = std::make_shared<AsyncState>();
+        TAsync<R> result(task->get_future(), state);
+        WorkerPool::instance().push([task, state]() {
+            (*task)();
+            state->complete();
+        });
+        return result;
+    }
+
+} // end of namespace detail
+
+// TVector members (declared in core_TVector.h)
+//-------------------------------------
+template <class T, class Allocator>
+template <class Less>
+TAsync<void>
+TVector<T, Allocator>::sort_async(Less less) & {
+    return detail::runAsync<void>([this, less]() {
+        TVECTOR_TRACE_SCOPE("sort_async", size(), -1);
+        detail::sortAsync(*this, less);
+    });
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Less>
+TAsync<TVector<T, Allocator>>
+TVector<T, Allocator>::sort_async(Less less) && {
+    auto items = std::make_shared<tvector>(std::move(*this));
+    return detail::runAsync<tvector>([items, less]() {
+        TVECTOR_TRACE_SCOPE("sort_async", items->size(), -1);
+        detail::sortAsync(*items, less);
+        return std::move(*items);
+    });
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class UnaryOperation>
+TAsync<void>
+TVector<T, Allocator>::transform_async(UnaryOperation op) & {
+    return detail::runAsync<void>([this, op]() {
+        TVECTOR_TRACE_SCOPE("transform_async", size(), -1);
+        std::transform(begin(), end(), begin(), op);
+    });
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class UnaryOperation>
+TAsync<TVector<T, Allocator>>
+TVector<T, Allocator>::transform_async(UnaryOperation op) && {
+    auto items = std::make_shared<tvector>(std::move(*this));
+    return detail::runAsync<tvector>([items, op]() {
+        TVECTOR_TRACE_SCOPE("transform_async", items->size(), -1);
+        std::transform(items->begin(), items->end(), items->begin(), op);
+        return std::move(*items);
+    });
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class U, class BinaryOperation>
+TAsync<U>
+TVector<T, Allocator>::reduce_async(U init, BinaryOperation op) const {
+    return detail::runAsync<U>([this, init, op]() {
+        TVECTOR_TRACE_SCOPE("reduce_async", size(), -1);
+        return std::accumulate(cbegin(), cend(), init, op);
+    });
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Predicate>
+TAsync<TVector<T, Allocator>>
+TVector<T, Allocator>::filter_async(Predicate pred) const & {
+    return detail::runAsync<tvector>([this, pred]() {
+        TVECTOR_TRACE_SCOPE("filter_async", size(), -1);
+        tvector output;
+        std::copy_if(cbegin(), cend(), std::back_inserter(output), pred);
+        return output;
+    });
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Predicate>
+TAsync<TVector<T, Allocator>>
+TVector<T, Allocator>::filter_async(Predicate pred) && {
+    auto items = std::make_shared<tvector>(std::move(*this));
+    return detail::runAsync<tvector>([items, pred]() {
+        TVECTOR_TRACE_SCOPE("filter_async", items->size(), -1);
+        items->erase(std::remove_if(items->begin(), items->end(), [&pred](const T &value) { return !pred(value); }), items->end());
+        return std::move(*items);
+    });
+}
+
+} // end of namespace
@@ -0,0 +1,312 @@
+#pragma once
+
+#include "core_TVector.h"
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace MindShake {
+
+//-------------------------------------
+// Split block Bloom filter (Putze, Sanders & Singler, 2007; the layout of Parquet and Impala).
+// Every value sets 8 bits inside one block of 8 words of 64 bits (64 bytes, aligned: one cache line):
+// one bit in each word. Testing a value reads one cache line, and the 8 word tests have no branches
+// (the compiler turns them into SIMD operations: one with 512 bit registers, two with 256 bit ones).
+// There are no false negatives. False positives happen with the rate given for the expected number of
+// elements, and grow when more elements are inserted (see TBloomVector, which rebuilds it).
+//-------------------------------------
+template <class T, class Hash = std::hash<T>>
+class TBloomFilter {
+public:
+    using size_type = size_t;
+
+    static constexpr size_type kWords = 8;     // Per block
+    static constexpr size_type kBits  = 64;    // Per word
+
+public:
+    // falsePositiveRate must be in (0, 1): std::invalid_argument otherwise
+    explicit TBloomFilter(size_type expected = 0, double falsePositiveRate = 0.01, Hash hash = Hash {})
+        : mHash(hash), mNumBlocks(blocksFor(expected, falsePositiveRate)), mCapacity(expected), mRate(falsePositiveRate) {
+        allocate();
+    }
+
+    // Filter for the elements of a container
+    template <class Container>
+    static TBloomFilter from(const Container &items, double falsePositiveRate = 0.01, Hash hash = Hash {}) {
+        TBloomFilter filter(items.size(), falsePositiveRate, hash);
+        for (const auto &item : items)
+            filter.insert(item);
+        return filter;
+    }
+
+    TBloomFilter(const TBloomFilter &other)
+        : mHash(other.mHash), mNumBlocks(other.mNumBlocks), mCapacity(other.mCapacity), mSize(other.mSize), mRate(other.mRate) {
+        allocate();
+        memcpy(mStorage.data() + mOffset, other.mStorage.data() + other.mOffset, bytes());
+    }
+    TBloomFilter(TBloomFilter &&) noexcept                                  = default;     // The buffer (and its alignment) moves
+    TBloomFilter & operator=(const TBloomFilter &other)                     { if (this != &other) *this = TBloomFilter(other); return *this; }
+    TBloomFilter & operator=(TBloomFilter &&) noexcept                      = default;
+
+    void insert(const T &value) {
+        const uint64_t hash  = mixedHash(value);
+        uint64_t       *block = mStorage.data() + blockOffset(hash);
+        uint64_t       mask[kWords];
+        makeMask(uint32_t(hash), mask);
+        for (size_type i = 0; i < kWords; ++i)
+            block[i] |= mask[i];
+        ++mSize;
+    }
+
+    // false: value was never inserted. true: it may have been inserted
+    bool may_contain(const T &value) const {
+        const uint64_t hash  = mixedHash(value);
+        const uint64_t *block = mStorage.data() + blockOffset(hash);
+        uint64_t       mask[kWords];
+        makeMask(uint32_t(hash), mask);
+
+        uint64_t missing = 0;
+        for (size_type i = 0; i < kWords; ++i)
+            missing |= ~block[i] & mask[i];
+        return missing == 0;
+    }
+
+    void clear() {
+        std::fill(mStorage.begin(), mStorage.end(), 0);
+        mSize = 0;
+    }
+
+    // Number of insertions (repeated values count every time)
+    size_type   size() const                                                { return mSize;                                                 }
+    // Expected number of elements it was built for
+    size_type   capacity() const                                            { return mCapacity;                                             }
+    size_type   bytes() const                                               { return mNumBlocks * kWords * sizeof(uint64_t);                }
+    // False positive rate given for capacity() elements, and estimation for the current size()
+    double      target_false_positive_rate() const                          { return mRate;                                                 }
+    double      false_positive_rate() const                                 { return estimateRate(mSize, mNumBlocks);                       }
+
+protected:
+    static constexpr size_type kMaxGrowSteps = 128;
+
+    uint64_t mixedHash(const T &value) const                                { return detail::mixHash(uint64_t(mHash(value)));              }
+
+    // The high half of the hash selects the block (multiply-shift instead of a modulo), the low half the bits
+    size_type blockOffset(uint64_t hash) const {
+        return mOffset + size_type(((hash >> 32) * uint64_t(mNumBlocks)) >> 32) * kWords;
+    }
+
+    // Blocks aligned to their size: a block is never split between two cache lines
+    void allocate() {
+        const size_t blockBytes = sizeof(uint64_t) * kWords;
+        mStorage.assign(mNumBlocks * kWords + kWords - 1, 0);
+        const size_t address = size_t(reinterpret_cast<uintptr_t>(mStorage.data()));
+        mOffset = ((blockBytes - address % blockBytes) % blockBytes) / sizeof(uint64_t);
+    }
+
+    static void makeMask(uint32_t key, uint64_t mask[kWords]) {
+        static const uint32_t kSalt[kWords] = {
+            0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+        };
+        for (size_type i = 0; i < kWords; ++i)
+            mask[i] = uint64_t(1) << ((key * kSalt[i]) >> 26);
+    }
+
+    // Probability that the 8 bits of a value are set in a block holding j values, weighted by the
+    // (Poisson) distribution of values per block
+    static double estimateRate(size_type count, size_type numBlocks) {
+        if (count == 0)
+            return 0.0;
+
+        const double lambda = double(count) / double(numBlocks);
+        const size_t last   = size_t(lambda * 4.0) + 32;
+        double       weight = std::exp(-lambda);    // P(j = 0)
+        double       rate   = 0.0;
+        for (size_t j = 1; j <= last; ++j) {
+            weight *= lambda / double(j);
+            rate   += weight * std::pow(1.0 - std::pow(1.0 - 1.0 / double(kBits), double(j)), double(kWords));
+        }
+        return rate;
+    }
+
+    static size_type blocksFor(size_type expected, double rate) {
+        if (!(rate > 0.0 && rate < 1.0))
+            throw std::invalid_argument("TBloomFilter: the false positive rate must be greater than 0 and less than 1");
+        if (expected == 0)
+            return 1;
+
+        // Start at the bits per element of a classic Bloom filter with 8 hashes and grow by 1/16
+        // (at most kMaxGrowSteps times: below ~1e-9 the rate only goes down slowly)
+        const double bits      = -double(kWords) / std::log(1.0 - std::pow(std::max(rate, 1e-9), 1.0 / double(kWords)));
+        size_type    numBlocks = std::max<size_type>(1, size_type(double(expected) * bits / double(kWords * kBits)));
+        for (size_type step = 0; step < kMaxGrowSteps && estimateRate(expected, numBlocks) > rate; ++step)
+            numBlocks += std::max<size_type>(1, numBlocks / 16);
+        return numBlocks;
+    }
+
+protected:
+    Hash                    mHash      {};
+    size_type               mNumBlocks = 1;
+    std::vector<uint64_t>   mStorage;
+    size_type               mOffset    = 0;    // First aligned word of mStorage
+    size_type               mCapacity  = 0;
+    size_type               mSize      = 0;
+    double                  mRate      = 0.01;
+};
+
+//-------------------------------------
+// TVector with a TBloomFilter kept up to date on every append.
+// Lookups of values that are not in the vector (most of them stop at the filter) cost one cache miss
+// instead of a scan. Elements can be read but not modified in place (the filter would not know it):
+// release() hands off the TVector. When the size reaches the capacity of the filter it is rebuilt
+// twice as big, so the false positive rate stays the given one.
+//-------------------------------------
+template <class T, class Hash = std::hash<T>, class Allocator = std::allocator<T>>
+class TBloomVector {
+public:
+    using tvector         = TVector<T, Allocator>;
+    using filter_type     = TBloomFilter<T, Hash>;
+    using size_type       = size_t;
+    using value_type      = T;
+    using const_iterator  = typename tvector::const_iterator;
+
+    static constexpr size_type kMinFilterCapacity = 64;
+
+public:
+    explicit TBloomVector(double falsePositiveRate = 0.01, Hash hash = Hash {})
+        : mFilter(kMinFilterCapacity, falsePositiveRate, hash), mHash(hash), mRate(falsePositiveRate) { }
+
+    explicit TBloomVector(tvector items, double falsePositiveRate = 0.01, Hash hash = Hash {})
+        : mItems(std::move(items)), mHash(hash), mRate(falsePositiveRate) {
+        rebuild(std::max(kMinFilterCapacity, mItems.size()));
+    }
+
+    // Add new elements
+    //---------------------------------
+    void        push_back(const T &value)                                   { grow(size() + 1); mItems.push_back(value); mFilter.insert(mItems.back());             }
+    void        push_back(T &&value)                                        { grow(size() + 1); mItems.push_back(std::move(value)); mFilter.insert(mItems.back());  }
+
+    template <class... Args>
+    T &         emplace_back(Args &&... args) {
+        grow(size() + 1);
+        mItems.emplace_back(std::forward<Args>(args)...);
+        mFilter.insert(mItems.back());
+        return mItems.back();
+    }
+
+    bool        push_back_if_new(const T &value)                            { if (contains(value)) return false; push_back(value); return true;             }
+    bool        push_back_if_new(T &&value)                                 { if (contains(value)) return false; push_back(std::move(value)); return true;  }
+
+    template <class... Args>
+    bool emplace_back_if_new(Args &&... args) {
+        T obj(std::forward<Args>(args)...);
+        return push_back_if_new(std::move(obj));
+    }
+
+    void reserve(size_type capacity) {
+        mItems.reserve(capacity);
+        grow(capacity);
+    }
+
+    // Search (the vector is only scanned when the filter says maybe)
+    //---------------------------------
+    const_iterator find(const T &value) const                               { return mItems.find(value, mFilter);                           }
+    bool        contains(const T &value) const                              { return mItems.contains(value, mFilter);                       }
+    ptrdiff_t   get_index(const T &value) const                             { return mItems.get_index(value, mFilter);                      }
+    size_type   count(const T &value) const                                 { return mFilter.may_contain(value) ? mItems.count(value) : 0;  }
+
+    // Removes the first element equal to value. Its bits stay in the filter: it only adds false positives
+    // until the next rebuild.
+    bool        eraseValue(const T &value)                                  { return mFilter.may_contain(value) && mItems.eraseValue(value); }
+
+    // Element access (read only)
+    //---------------------------------
+    size_type   size() const                                                { return mItems.size();                                         }
+    bool        empty() const                                               { return mItems.empty();                                        }
+    const T &   operator[](size_type idx) const                             { return mItems[idx];                                           }
+    const T &   at(size_type idx) const                                     { return mItems.at(idx);                                        }
+    const_iterator begin() const                                            { return mItems.cbegin();                                       }
+    const_iterator end() const                                              { return mItems.cend();                                         }
+    const_iterator cbegin() const                                           { return mItems.cbegin();                                       }
+    const_iterator cend() const                                             { return mItems.cend();                                         }
+
+    const tvector &     items() const                                       { return mItems;                                                }
+    const filter_type & filter() const                                      { return mFilter;                                               }
+
+    // Hand off
+    //---------------------------------
+    // Moves the elements out and leaves this container empty
+    tvector release() {
+        tvector result = std::move(mItems);
+        clear();
+        return result;
+    }
+
+    void clear() {
+        mItems.clear();
+        rebuild(kMinFilterCapacity);
+    }
+
+protected:
+    void grow(size_type needed) {
+        if (needed > mFilter.capacity())
+            rebuild(std::max(needed, mFilter.capacity() * 2));
+    }
+
+    void rebuild(size_type capacity) {
+        mFilter = filter_type(capacity, mRate, mHash);
+        for (const auto &item : mItems)
+            mFilter.insert(item);
+    }
+
+protected:
+    tvector         mItems;
+    filter_type     mFilter;
+    Hash            mHash   {};
+    double          mRate   = 0.01;
+};
+
+// TVector members (declared in core_TVector.h)
+//-------------------------------------
+template <class T, class Allocator>
+template <class Hash>
+typename TVector<T, Allocator>::const_iterator
+TVector<T, Allocator>::find(const T &value, const TBloomFilter<T, Hash> &filter) const {
+    return filter.may_contain(value) ? std::find(cbegin(), cend(), value) : cend();
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Hash>
+bool
+TVector<T, Allocator>::contains(const T &value, const TBloomFilter<T, Hash> &filter) const {
+    return find(value, filter) != cend();
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Hash>
+ptrdiff_t
+TVector<T, Allocator>::get_index(const T &value, const TBloomFilter<T, Hash> &filter) const {
+    auto it = find(value, filter);
+    return (it != cend()) ? it - cbegin() : -1;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Hash>
+bool
+TVector<T, Allocator>::push_back_if_new(const T &value, TBloomFilter<T, Hash> &filter) {
+    if (contains(value, filter))
+        return false;
+
+    push_back(value);
+    filter.insert(value);
+    return true;
+}
+
+} // end of namespace
@@ -0,0 +1,302 @@
+#pragma once
+
+#include "core_TVector.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace MindShake {
+
+//-------------------------------------
+// Append-only vector that accepts push_back / emplace_back from several threads at the same time.
+// - Each producer reserves its slot with an atomic counter, so producers never wait for each other.
+// - Elements live in segments (each one twice as big as the previous) that never move,
+//   so a published element can be read while other threads keep appending.
+// - freeze() hands off the elements as a regular TVector once every producer has finished.
+// - In contiguous mode every element goes to one buffer reserved up front, and freeze() hands off
+//   that same buffer.
+//-------------------------------------
+template <class T, class Allocator = std::allocator<T>>
+class TConcurrentVector {
+public:
+    using tvector         = TVector<T, Allocator>;
+    using size_type       = size_t;
+    using value_type      = T;
+    using allocator_type  = Allocator;
+
+    // Tag of the contiguous mode constructor
+    struct contiguous_t { explicit contiguous_t() = default; };
+    static constexpr contiguous_t contiguous {};
+
+public:
+    // capacity is a hint: the first segment will hold at least that number of elements
+    explicit TConcurrentVector(size_type capacity = 0, const Allocator &alloc = Allocator {})
+        : mAlloc(alloc), mBuffer(alloc) {
+        while (mFirstShift < kMaxFirstShift && (size_type(1) << mFirstShift) < capacity)
+            ++mFirstShift;
+    }
+
+    // Contiguous mode: the elements go to one TVector of capacity elements, that freeze() returns without moving
+    // them. Its slots are value initialized here and the producers move assign to theirs, so T must be default
+    // constructible and move assignable. Once it is full push_back / emplace_back throw std::length_error.
+    //   TConcurrentVector<int> values(TConcurrentVector<int>::contiguous, 8000);
+    TConcurrentVector(contiguous_t, size_type capacity, const Allocator &alloc = Allocator {})
+        : TConcurrentVector(capacity, alloc) {
+        mBuffer.resize(capacity);
+        mReady.reset(new std::atomic<uint8_t>[capacity]());
+        mContiguous = true;
+    }
+
+    TConcurrentVector(const TConcurrentVector &)             = delete;
+    TConcurrentVector & operator=(const TConcurrentVector &) = delete;
+
+    ~TConcurrentVector()                                                    { clear();                                                      }
+
+    // Add new elements (thread safe)
+    //---------------------------------
+    // Returns the index of the new element
+    size_type   push_back(const T &value)                                   { return emplace_back(value);                                   }
+    size_type   push_back(T &&value)                                        { return emplace_back(std::move(value));                        }
+
+    template <class... Args>
+    size_type emplace_back(Args &&... args) {
+        size_type idx     = mSize.fetch_add(1, std::memory_order_relaxed);
+        if (mContiguous) {
+            if (idx >= mBuffer.size())
+                throw std::length_error("TConcurrentVector: the contiguous buffer is full");
+            mBuffer[idx] = T(std::forward<Args>(args)...);
+            mReady[idx].store(1, std::memory_order_release);
+            return idx;
+        }
+
+        size_type offset  = 0;
+        Segment   *seg    = getSegment(locate(idx, offset));
+
+        AllocTraits::construct(mAlloc, seg->items + offset, std::forward<Args>(args)...);
+        // If the constructor throws the slot is never published and it will be skipped
+        seg->ready[offset].store(1, std::memory_order_release);
+        return idx;
+    }
+
+    // Preallocates segments until capacity elements fit (thread safe). The contiguous buffer does not grow.
+    void reserve(size_type capacity) {
+        if (mContiguous) {
+            if (capacity > mBuffer.size())
+                throw std::length_error("TConcurrentVector::reserve: the contiguous buffer does not grow");
+            return;
+        }
+
+        size_type offset = 0;
+        if (capacity > 0)
+            for (size_type s = 0, last = locate(capacity - 1, offset); s <= last; ++s)
+                getSegment(s);
+    }
+
+    // Element access (thread safe for published elements)
+    //---------------------------------
+    // Number of reserved slots. Some of them may not be published yet.
+    size_type size() const {
+        size_type n = mSize.load(std::memory_order_acquire);
+        return mContiguous ? std::min(n, mBuffer.size()) : n;       // Without the slots refused when it was full
+    }
+    bool        empty() const                                               { return size() == 0;                                           }
+    size_type   capacity() const {
+        if (mContiguous)
+            return mBuffer.size();
+
+        size_type total = 0;
+        for (size_type s = 0; s < kMaxSegments; ++s) {
+            if (mSegments[s].load(std::memory_order_acquire) != nullptr)
+                total += segmentSize(s);
+        }
+        return total;
+    }
+
+    bool is_published(size_type idx) const {
+        if (idx >= size())
+            return false;
+        if (mContiguous)
+            return mReady[idx].load(std::memory_order_acquire) != 0;
+
+        size_type     offset = 0;
+        const Segment *seg   = mSegments[locate(idx, offset)].load(std::memory_order_acquire);
+        return (seg != nullptr) && seg->ready[offset].load(std::memory_order_acquire) != 0;
+    }
+
+    // The element must be published (see is_published)
+    const T &   operator[](size_type idx) const                             { return const_cast<TConcurrentVector *>(this)->item(idx);      }
+          T &   operator[](size_type idx)                                   { return item(idx);                                             }
+
+    const T &   at(size_type idx) const                                     { return const_cast<TConcurrentVector *>(this)->at(idx);        }
+          T &   at(size_type idx) {
+        if (is_published(idx) == false)
+            throw std::out_of_range("TConcurrentVector::at: element not published");
+        return item(idx);
+    }
+
+    // Calls op(idx, value) for every published element, in index order
+    template <class Func>
+    void for_each_published(Func op) const {
+        for (size_type idx = 0, n = size(); idx < n; ++idx) {
+            if (is_published(idx))
+                op(idx, (*this)[idx]);
+        }
+    }
+
+    // Hand off (NOT thread safe: no producer can be running)
+    //---------------------------------
+    // Moves the published elements, in index order, into a TVector and leaves this container empty.
+    // Elements are moved, never copied, and the result is allocated once.
+    // In contiguous mode the result is the buffer itself: the elements only move to close the gaps of the
+    // slots never published (a constructor threw). Afterwards the container grows in segments.
+    tvector freeze() {
+        if (mContiguous) {
+            size_type n      = size();
+            tvector   result = std::move(mBuffer);
+            size_type kept   = 0;
+            for (size_type i = 0; i < n; ++i) {
+                if (mReady[i].load(std::memory_order_relaxed)) {
+                    if (kept != i)
+                        result[kept] = std::move(result[i]);
+                    ++kept;
+                }
+            }
+            result.erase(result.begin() + kept, result.end());
+            clear();
+            return result;
+        }
+
+        tvector result(mAlloc);
+
+        size_type n = size();
+        result.reserve(n);
+        for (size_type s = 0; s < kMaxSegments && segmentStart(s) < n; ++s) {
+            Segment *seg = mSegments[s].load(std::memory_order_acquire);
+            if (seg == nullptr)
+                continue;
+
+            size_type count = std::min(segmentSize(s), n - segmentStart(s));
+            for (size_type i = 0; i < count; ++i) {
+                if (seg->ready[i].load(std::memory_order_relaxed))
+                    result.emplace_back(std::move(seg->items[i]));
+            }
+        }
+        clear();
+        return result;
+    }
+
+    // Destroys all the elements and releases the memory (ending the contiguous mode)
+    void clear() {
+        if (mContiguous) {
+            tvector(mAlloc).swap(mBuffer);
+            mReady.reset();
+            mContiguous = false;
+        }
+
+        size_type n = mSize.load(std::memory_order_acquire);
+        for (size_type s = 0; s < kMaxSegments; ++s) {
+            Segment *seg = mSegments[s].exchange(nullptr, std::memory_order_acq_rel);
+            if (seg == nullptr)
+                continue;
+
+            size_type first = segmentStart(s);
+            size_type count = segmentSize(s);
+            for (size_type i = 0; i < count && first + i < n; ++i) {
+                if (seg->ready[i].load(std::memory_order_relaxed))
+                    AllocTraits::destroy(mAlloc, seg->items + i);
+            }
+            freeSegment(seg, count);
+        }
+        mSize.store(0, std::memory_order_release);
+    }
+
+protected:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    struct Segment {
+        T                       *items;
+        std::atomic<uint8_t>    *ready;
+    };
+
+    static constexpr size_type kMaxSegments   = 48;
+    static constexpr size_type kMaxFirstShift = 24;
+
+    // Segment s holds (first << s) elements and starts at first * (2^s - 1)
+    size_type   segmentSize(size_type s) const                              { return size_type(1) << (mFirstShift + s);                     }
+    size_type   segmentStart(size_type s) const                             { return ((size_type(1) << s) - 1) << mFirstShift;              }
+
+    size_type locate(size_type idx, size_type &offset) const {
+        size_type s = floorLog2((idx >> mFirstShift) + 1);
+        offset = idx - segmentStart(s);
+        return s;
+    }
+
+    static size_type floorLog2(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return size_type(63 - __builtin_clzll(value));
+#elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long idx;
+        _BitScanReverse64(&idx, value);
+        return size_type(idx);
+#else
+        size_type s = 0;
+        while (value >>= 1)
+            ++s;
+        return s;
+#endif
+    }
+
+    Segment * getSegment(size_type s) {
+        Segment *seg = mSegments[s].load(std::memory_order_acquire);
+        if (seg != nullptr)
+            return seg;
+
+        Segment *created = allocSegment(segmentSize(s));
+        if (mSegments[s].compare_exchange_strong(seg, created, std::memory_order_acq_rel, std::memory_order_acquire))
+            return created;
+
+        // Another thread was faster
+        freeSegment(created, segmentSize(s));
+        return seg;
+    }
+
+    Segment * allocSegment(size_type count) {
+        // Released if the next allocation throws
+        std::unique_ptr<Segment>                seg(new Segment);
+        std::unique_ptr<std::atomic<uint8_t>[]> ready(new std::atomic<uint8_t>[count]());
+        seg->items = AllocTraits::allocate(mAlloc, count);
+        seg->ready = ready.release();
+        return seg.release();
+    }
+
+    void freeSegment(Segment *seg, size_type count) {
+        AllocTraits::deallocate(mAlloc, seg->items, count);
+        delete [] seg->ready;
+        delete seg;
+    }
+
+    T & item(size_type idx) {
+        if (mContiguous)
+            return mBuffer[idx];
+
+        size_type offset = 0;
+        Segment   *seg   = mSegments[locate(idx, offset)].load(std::memory_order_acquire);
+        return seg->items[offset];
+    }
+
+protected:
+    Allocator                   mAlloc;
+    size_type                   mFirstShift { 5 };
+    std::atomic<size_type>      mSize { 0 };
+    std::atomic<Segment *>      mSegments[kMaxSegments] {};
+    tvector                     mBuffer;                // Contiguous mode
+    std::unique_ptr<std::atomic<uint8_t>[]> mReady;
+    bool                        mContiguous { false };
+};
+
+} // end of namespace
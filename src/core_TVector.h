@@ -0,0 +1,1439 @@
+#pragma once
+
+//-------------------------------------
+// Core of TVector: the class and every member that only needs <vector>, <algorithm> and <functional>.
+// Members that need heavy headers are declared here and defined in:
+//   - algorithm_TVector.h: transform / reduce / transform_reduce / argsort with an execution policy (<execution>)
+//   - random_TVector.h:    shuffle, partial_shuffle and sample (<random>)
+//   - parallel_TVector.h:  shuffle, top_k, merge_sorted, *_many searches, count_by, aggregate_by, scans, partitions, for_each and the cancellable operations with an execution policy (threads)
+//   - sort_TVector.h:      sort_by, stable_sort_by, argsort, apply_permutation and top_k
+//   - set_TVector.h:       set operations and k-way merge of sorted vectors
+//   - search_TVector.h:    search index and batched searches for big sorted vectors
+//   - group_TVector.h:     count_by, aggregate_by and group_by (hash grouping)
+//   - async_TVector.h:     sort_async, transform_async, reduce_async and filter_async (worker threads, <future>)
+//   - bloom_TVector.h:     find, contains, get_index and push_back_if_new with a Bloom filter (not included by TVector.h)
+// The execution policies are in policy_TVector.h. resolvePolicy, ExecutionThresholds::global() and TCancellationToken
+// need thread headers and are in threads_TVector.h, included by the algorithm, parallel and async headers.
+// TVector.h includes all of them. Include only this one where those members are not used, or
+// where they come already instantiated (see TVECTOR_EXTERN_TEMPLATES below).
+//-------------------------------------
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include "policy_TVector.h"
+
+#if defined(TVECTOR_TELEMETRY)
+    #include "telemetry_TVector.h"
+#elif !defined(TVECTOR_TELEMETRY_SCOPE)
+    #define TVECTOR_TELEMETRY_SCOPE(tag)
+    #define TVECTOR_TELEMETRY_SITE()
+#endif
+
+#if defined(TVECTOR_TRACE)
+    #include "trace_TVector.h"
+#elif !defined(TVECTOR_TRACE_SCOPE)
+    #define TVECTOR_TRACE_SCOPE(name, count, policy)
+#endif
+
+namespace MindShake {
+
+template <class T, class Less>
+class TSearchIndex;     // search_TVector.h
+template <class Key, class T>
+struct TGroups;         // group_TVector.h
+template <class R>
+class TAsync;           // async_TVector.h
+template <class T, class Hash>
+class TBloomFilter;     // bloom_TVector.h
+
+namespace detail {
+
+    //---------------------------------
+    inline void
+    prefetch(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void) address;
+#endif
+    }
+
+    //---------------------------------
+    // Spreads the bits of a hash (splitmix64 finalizer): std::hash of integers is the identity in some libraries
+    inline uint64_t
+    mixHash(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    // std::hash of any key
+    struct DefaultHash {
+        template <class Key>
+        size_t operator()(const Key &key) const                             { return std::hash<Key> {}(key);    }
+    };
+
+    //---------------------------------
+    // Position of the first element of [first, first + n) for which before(element, value) is false.
+    // The range halves every step and the comparison only selects the next base (a conditional move, not a branch).
+    template <class Iterator, class Value, class Before>
+    constexpr Iterator
+    branchlessBound(Iterator first, size_t n, const Value &value, Before before) {
+        if (n == 0)
+            return first;
+
+        while (n > 1) {
+            const size_t half = n / 2;
+            // Both possible next probes, as the branch predictor of a branchy search would do for one of them
+            prefetch(&first[half / 2]);
+            prefetch(&first[half + half / 2]);
+            first = before(first[half], value) ? first + half : first;
+            n    -= half;
+        }
+        return first + ptrdiff_t(before(*first, value));
+    }
+
+    //---------------------------------
+    // Inclusive scan of floating point values by addition, 4 at a time: the prefix sums inside a block do not
+    // depend on the carry, so they overlap with the previous blocks and only one addition per block waits
+    // for the one before (the dependency chain is 4 times shorter; the same shape as a SIMD register scan).
+    // It is plain scalar code, and it groups the additions differently than a left to right loop (so it
+    // can round differently): only the scans with an execution policy other than seq use it.
+    template <class T, class Output>
+    inline T
+    inclusiveSumBlocks(const T *input, Output output, size_t n, T carry) {
+        const size_t blocks = n & ~size_t(3);
+        size_t       i      = 0;
+        for (; i < blocks; i += 4) {
+            const T p0 = input[i];
+            const T p1 = p0 + input[i + 1];
+            const T p2 = p1 + input[i + 2];
+            const T p3 = p2 + input[i + 3];
+            output[i]     = carry + p0;
+            output[i + 1] = carry + p1;
+            output[i + 2] = carry + p2;
+            output[i + 3] = carry + p3;
+            carry        += p3;
+        }
+        for (; i < n; ++i) {
+            carry    += input[i];
+            output[i] = carry;
+        }
+        return carry;
+    }
+
+    // Floating point addition, the case of inclusiveSumBlocks. Integer sums and other operations use the
+    // plain left to right loop (integer additions are too fast to gain from the blocks).
+    template <class T, class Op>
+    using IsFloatSum = std::integral_constant<bool, std::is_floating_point<T>::value &&
+        (std::is_same<Op, std::plus<T>>::value || std::is_same<Op, std::plus<>>::value)>;
+
+    struct Identity {
+        template <class V>
+        constexpr V && operator()(V &&value) const                          { return std::forward<V>(value);   }
+    };
+
+    //---------------------------------
+    // Inclusive scan of transform(input[i]) into output, after carry when there is one. Both can be the same.
+    template <class Input, class Output, class Op, class Transform, class U>
+    inline void
+    inclusiveScan(Input input, size_t n, Output output, Op &op, Transform &transform, const U *carry) {
+        if (n == 0)
+            return;
+
+        U acc = carry ? op(*carry, transform(input[0])) : U(transform(input[0]));
+        output[0] = acc;
+        for (size_t i = 1; i < n; ++i) {
+            acc       = op(std::move(acc), transform(input[i]));
+            output[i] = acc;
+        }
+    }
+
+    // Exclusive scan: output[i] = carry op transform(input[0]) op ... op transform(input[i - 1])
+    template <class Input, class Output, class Op, class Transform, class U>
+    inline void
+    exclusiveScan(Input input, size_t n, Output output, Op &op, Transform &transform, U acc) {
+        for (size_t i = 0; i < n; ++i) {
+            U next    = op(acc, transform(input[i]));     // Read input[i] before writing output[i] (in place)
+            output[i] = std::move(acc);
+            acc       = std::move(next);
+        }
+    }
+
+    // Inclusive scan of items into output (both can be the same) after carry (if any), with
+    // inclusiveSumBlocks for float sums
+    template <class T, class Output, class Op>
+    inline void
+    inclusiveScanBlocks(const T *items, size_t n, Output output, Op &, const T *carry, std::true_type /*floatSum*/) {
+        if (n != 0)
+            inclusiveSumBlocks(items, output, n, carry ? *carry : T(0));
+    }
+
+    template <class T, class Output, class Op>
+    inline void
+    inclusiveScanBlocks(const T *items, size_t n, Output output, Op &op, const T *carry, std::false_type /*floatSum*/) {
+        Identity identity;
+        inclusiveScan(items, n, output, op, identity, carry);
+    }
+
+    // SFINAE: Op can combine two T (tells an operation from an output iterator in overloads)
+    template <class Op, class T>
+    using BinaryOpOf = decltype(std::declval<Op &>()(std::declval<const T &>(), std::declval<const T &>()));
+
+    // element < value (lower_bound) and !(value < element) (upper_bound)
+    template <class Less>
+    struct LowerBefore {
+        template <class A, class B>
+        constexpr bool operator()(const A &element, const B &value) const   { return less(element, value);      }
+        Less less;
+    };
+
+    template <class Less>
+    struct UpperBefore {
+        template <class A, class B>
+        constexpr bool operator()(const A &element, const B &value) const   { return !less(value, element);     }
+        Less less;
+    };
+
+} // end of namespace detail
+
+//-------------------------------------
+template <class T, class Allocator = std::allocator<T>>
+class TVector : public std::vector<T, Allocator> {
+public:
+    using vector  = std::vector<T, Allocator>;
+    using tvector = TVector<T, Allocator>;
+
+    using std::vector<T, Allocator>::vector;        // Inherits constructors
+    using std::vector<T, Allocator>::operator =;
+    // Element access
+    //using std::vector<T, Allocator>::at;
+    //using std::vector<T, Allocator>::operator [];
+    using std::vector<T, Allocator>::front;
+    using std::vector<T, Allocator>::back;
+    using std::vector<T, Allocator>::data;
+    // Iterators
+    using std::vector<T, Allocator>::begin;
+    using std::vector<T, Allocator>::cbegin;
+    using std::vector<T, Allocator>::end;
+    using std::vector<T, Allocator>::cend;
+    using std::vector<T, Allocator>::rbegin;
+    using std::vector<T, Allocator>::crbegin;
+    using std::vector<T, Allocator>::rend;
+    using std::vector<T, Allocator>::crend;
+    // Capacity
+    using std::vector<T, Allocator>::empty;
+    using std::vector<T, Allocator>::size;
+    using std::vector<T, Allocator>::max_size;
+    using std::vector<T, Allocator>::capacity;
+    // Modifiers
+    //using std::vector<T, Allocator>::clear;
+    using std::vector<T, Allocator>::pop_back;
+    using std::vector<T, Allocator>::swap;
+#if !defined(TVECTOR_TELEMETRY)
+    // With telemetry these are wrapped (see below)
+    using std::vector<T, Allocator>::reserve;
+    using std::vector<T, Allocator>::shrink_to_fit;
+    using std::vector<T, Allocator>::insert;
+    using std::vector<T, Allocator>::emplace;
+    using std::vector<T, Allocator>::erase;
+    using std::vector<T, Allocator>::push_back;
+    using std::vector<T, Allocator>::emplace_back;
+    using std::vector<T, Allocator>::resize;
+#endif
+
+    // GCC needs this
+    using size_type       = typename vector::size_type;
+    using difference_type = typename vector::difference_type;
+    using iterator        = typename vector::iterator;
+    using const_iterator  = typename vector::const_iterator;
+    using reverse_iterator       = typename vector::reverse_iterator;
+    using const_reverse_iterator = typename vector::const_reverse_iterator;
+
+    // Short names
+    using sizet           = size_type;
+    using ptrdiff         = difference_type;
+    using iter            = iterator;
+    using citer           = const_iterator;
+    using riter           = reverse_iterator;
+    using criter          = const_reverse_iterator;
+
+    // Functions
+    using FuncLess        = std::function<bool(const T &, const T &)>;
+
+    using pair            = std::pair<T &, T &>;
+    using cpair           = const std::pair<const T &, const T &>;
+
+public:
+    constexpr TVector()                             = default;
+    constexpr TVector(const vector &o) : vector(o) {}
+    constexpr TVector(vector &&o) noexcept : vector(std::move(o)) {}
+    constexpr TVector(const tvector &)              = default;
+    constexpr TVector(tvector &&)                   = default;
+
+    constexpr TVector & operator=(tvector &&)       = default;
+
+    // The inherited ones would return vector &
+    constexpr TVector & operator=(vector &&o) noexcept(std::is_nothrow_move_assignable<vector>::value) {
+        vector::operator=(std::move(o));
+        return *this;
+    }
+#if !defined(TVECTOR_TELEMETRY)
+    // With telemetry these are wrapped (see below)
+    constexpr TVector & operator=(const tvector &)  = default;
+    constexpr TVector & operator=(const vector &o)                          { vector::operator=(o); return *this;                           }
+    constexpr TVector & operator=(std::initializer_list<T> list)            { vector::operator=(list); return *this;                        }
+#endif
+
+    constexpr operator       vector &()                                     { return *reinterpret_cast<vector *>(this);                     }
+    constexpr operator const vector &() const                               { return *reinterpret_cast<const vector *>(this);               }
+
+    constexpr const T & operator[](ptrdiff idx) const                       { return vector::operator[](correctInsideIdx(idx));             }
+    constexpr       T & operator[](ptrdiff idx)                             { return vector::operator[](correctInsideIdx(idx));             }
+
+    constexpr const T & at(ptrdiff idx) const                               { return vector::at(correctInsideIdx(idx));                     }
+    constexpr       T & at(ptrdiff idx)                                     { return vector::at(correctInsideIdx(idx));                     }
+
+#if defined(TVECTOR_TELEMETRY)
+    // Telemetry: same members as std::vector, recording growths and shifted elements.
+    // Not recorded: constructors (copies included), move assignment and swap, which adopt a buffer.
+    //---------------------------------
+  protected:
+    // replaces: the previous elements are destroyed, not copied to the new buffer (assignments)
+    struct TelemetryProbe {
+        TelemetryProbe(const vector &v, size_t shifted = 0, bool replaces = false) : v(v), size(replaces ? 0 : v.size()), capacity(v.capacity()) {
+            TVectorTelemetry::recordShift(shifted);
+        }
+        ~TelemetryProbe() {
+            TVectorTelemetry::recordGrowth(sizeof(T), size, capacity, v.size(), v.capacity());
+        }
+
+        const vector    &v;
+        size_t          size;
+        size_t          capacity;
+    };
+
+  public:
+    TVector & operator=(const tvector &o)                                   { TelemetryProbe probe(*this, 0, true); vector::operator=(o); return *this;    }
+    TVector & operator=(const vector &o)                                    { TelemetryProbe probe(*this, 0, true); vector::operator=(o); return *this;    }
+    TVector & operator=(std::initializer_list<T> list)                      { TelemetryProbe probe(*this, 0, true); vector::operator=(list); return *this; }
+
+    void      assign(size_type n, const T &value)                           { TelemetryProbe probe(*this, 0, true); vector::assign(n, value);        }
+    template <class Input, class = typename std::iterator_traits<Input>::iterator_category>
+    void      assign(Input first, Input last)                               { TelemetryProbe probe(*this, 0, true); vector::assign(first, last);     }
+    void      assign(std::initializer_list<T> list)                         { TelemetryProbe probe(*this, 0, true); vector::assign(list);            }
+
+    void      reserve(size_type n)                                          { TelemetryProbe probe(*this); vector::reserve(n);              }
+    void      shrink_to_fit()                                               { TelemetryProbe probe(*this); vector::shrink_to_fit();         }
+
+    void      resize(size_type n)                                           { TelemetryProbe probe(*this); vector::resize(n);               }
+    void      resize(size_type n, const T &value)                           { TelemetryProbe probe(*this); vector::resize(n, value);        }
+
+    void      push_back(const T &value)                                     { TelemetryProbe probe(*this); vector::push_back(value);        }
+    void      push_back(T &&value)                                          { TelemetryProbe probe(*this); vector::push_back(std::move(value)); }
+
+    template <class... Args>
+    T &       emplace_back(Args &&... args) {
+        TelemetryProbe probe(*this);
+        vector::emplace_back(std::forward<Args>(args)...);
+        return back();
+    }
+
+    iterator  insert(const_iterator pos, const T &value)                    { TelemetryProbe probe(*this, cend() - pos); return vector::insert(pos, value);            }
+    iterator  insert(const_iterator pos, T &&value)                         { TelemetryProbe probe(*this, cend() - pos); return vector::insert(pos, std::move(value)); }
+    iterator  insert(const_iterator pos, size_type n, const T &value)       { TelemetryProbe probe(*this, cend() - pos); return vector::insert(pos, n, value);         }
+    template <class Input, class = typename std::iterator_traits<Input>::iterator_category>
+    iterator  insert(const_iterator pos, Input first, Input last)           { TelemetryProbe probe(*this, cend() - pos); return vector::insert(pos, first, last);      }
+    iterator  insert(const_iterator pos, std::initializer_list<T> list)     { TelemetryProbe probe(*this, cend() - pos); return vector::insert(pos, list);             }
+
+    template <class... Args>
+    iterator  emplace(const_iterator pos, Args &&... args)                  { TelemetryProbe probe(*this, cend() - pos); return vector::emplace(pos, std::forward<Args>(args)...); }
+
+    iterator  erase(const_iterator pos)                                     { TVectorTelemetry::recordShift(cend() - pos - 1); return vector::erase(pos);               }
+    iterator  erase(const_iterator first, const_iterator last)              { TVectorTelemetry::recordShift((first != last) ? cend() - last : 0); return vector::erase(first, last); }
+#endif
+
+    // Clear
+    //---------------------------------
+    constexpr tvector & clear()                                             { vector::clear(); return *this;                                }
+
+    // Insert methods
+    //---------------------------------
+    // If the users wants to insert at end, it should use insert(-1, value)
+    // Note: -1 == end(), -2 == end() - 1, ...
+    constexpr iterator  insert(ptrdiff idx, const T &value)                 { return insert(correct(idx), value);                           }
+    template <class Input>
+    constexpr iterator  insert(ptrdiff idx, Input first, Input last)        { return insert(correct(idx), first, last);                     }
+    constexpr iterator  insert(ptrdiff idx, std::initializer_list<T> list)  { return insert(correct(idx), list);                            }
+    constexpr iterator  insert(ptrdiff idx, const vector &v)                { return insert(correct(idx), v.cbegin(), v.cend());            }
+
+    // Emplace methods
+    //---------------------------------
+    // If the users wants to emplace at end, it should use emplace(-1, value)
+    // Note: -1 == end(), -2 == end() - 1, ...
+    template <class... Args>
+    constexpr iterator  emplace(ptrdiff idx, Args&&... args)                { return emplace(correct(idx), std::forward<Args>(args)...);    }
+
+    // Add new elements
+    //---------------------------------
+    constexpr bool push_back_if_new(const T &value) {
+        auto it = std::find(cbegin(), cend(), value);
+        if (it == cend()) {
+            push_back(value);
+            return true;
+        }
+
+        return false;
+    }
+
+    //---------------------------------
+    constexpr bool push_back_if_new(T &&value) {
+        auto it = std::find(cbegin(), cend(), value);
+        if (it == cend()) {
+            push_back(std::move(value));
+            return true;
+        }
+
+        return false;
+    }
+
+    //---------------------------------
+    template <class... Args>
+    constexpr bool emplace_back_if_new(Args &&... args) {
+        T    obj(std::forward<Args>(args)...);
+
+        auto it = std::find(cbegin(), cend(), obj);
+        if (it == cend()) {
+            emplace_back(std::move(obj));
+            return true;
+        }
+
+        return false;
+    }
+
+    // Erase methods
+    //---------------------------------
+    // If the users wants to erase the last element, it should use erase(-1)
+    // Note: -1 == end() - 1, -2 == end() - 2, ...
+    constexpr iterator  erase(ptrdiff idx)                                  { return erase(correctInside(idx));                             }
+    // Removes the elements in the range [first, last)
+    constexpr iterator  erase(ptrdiff first, ptrdiff last)                  { return erase(correctInside(first), correctInside(last));      }
+
+    // Changes element order
+    constexpr tvector & erase_quick(ptrdiff idx) {
+        std::swap(data()[correctInsideIdx(idx)], data()[size() - 1]);
+        pop_back();
+        return *this;
+    }
+
+    constexpr bool eraseValue(const T &value) {
+        auto it = std::find(begin(), end(), value); 
+        if (it != end()) { 
+            erase(it); 
+            return true; 
+        } 
+        return false;    
+    }
+
+    constexpr bool eraseAll(const T &value) {
+        auto it = std::remove(begin(), end(), value);
+        if (it != end()) {
+            erase(it, end());
+            return true;
+        }
+        return false;
+    }
+
+    // Find
+    //---------------------------------
+    constexpr const_iterator find(const T &value) const                     { return std::find(cbegin(), cend(), value);                    }
+    constexpr iterator       find(const T &value)                           { return std::find( begin(),  end(), value);                    }
+
+    constexpr const_iterator find_if(std::function<bool(const T &)> op) const {
+        return std::find_if(cbegin(), cend(), op);
+    }
+    constexpr iterator       find_if(std::function<bool(const T &)> op)     { return std::find_if(begin(), end(), op);                      }
+
+    constexpr const_iterator find_if_not(std::function<bool(const T &)> op) const {
+        return std::find_if_not(cbegin(), cend(), op);
+    }
+    constexpr iterator       find_if_not(std::function<bool(const T &)> op) { return std::find_if_not(begin(), end(), op);                  }
+
+    //-- C++23 --
+    constexpr const_reverse_iterator find_last(const T &value) const        { return std::find(crbegin(), crend(), value);                  }
+    constexpr reverse_iterator       find_last(const T &value)              { return std::find(rbegin(), rend(), value);                    }
+
+    constexpr const_reverse_iterator find_last_if(std::function<bool(const T &)> op) const {
+        return std::find_if(crbegin(), crend(), op);
+    }
+    constexpr reverse_iterator       find_last_if(std::function<bool(const T &)> op) {
+        return std::find_if(rbegin(), rend(), op);
+    }
+
+    constexpr const_reverse_iterator find_last_if_not(std::function<bool(const T &)> op) const {
+        return std::find_if_not(crbegin(), crend(), op);
+    }
+    constexpr reverse_iterator       find_last_if_not(std::function<bool(const T &)> op) {
+        return std::find_if_not(rbegin(), rend(), op);
+    }
+
+    // Contains
+    //---------------------------------
+    constexpr bool contains(const T &value)                                 { return std::find(cbegin(), cend(), value) != cend();          }
+
+    // Get Index
+    //---------------------------------
+    constexpr ptrdiff_t get_index(const T &value) {
+        auto it = std::find(cbegin(), cend(), value);
+        if (it != cend()) {
+            return it - cbegin();
+        }
+
+        return -1;
+    }
+
+    // With a Bloom filter of the elements (TBloomFilter::from(v)): values rejected by the filter are not
+    // searched. The filter must know every element; push_back_if_new inserts the new ones in it.
+    // Defined in bloom_TVector.h
+    //---------------------------------
+    template <class Hash>
+    const_iterator find(const T &value, const TBloomFilter<T, Hash> &filter) const;
+    template <class Hash>
+    bool      contains(const T &value, const TBloomFilter<T, Hash> &filter) const;
+    template <class Hash>
+    ptrdiff_t get_index(const T &value, const TBloomFilter<T, Hash> &filter) const;
+    template <class Hash>
+    bool      push_back_if_new(const T &value, TBloomFilter<T, Hash> &filter);
+
+    // Count
+    //---------------------------------
+    constexpr size_type count(const T &value) const                        { return std::count(cbegin(), cend(), value);                    }
+    constexpr size_type count_if(std::function<bool(const T &)> op) const  { return std::count_if(cbegin(), cend(), op);                    }
+
+    // Check
+    //---------------------------------
+    constexpr bool all_of(std::function<bool(const T &)> op) const         { return std::all_of(cbegin(), cend(), op);                      }
+    constexpr bool any_of(std::function<bool(const T &)> op) const         { return std::any_of(cbegin(), cend(), op);                      }
+    constexpr bool none_of(std::function<bool(const T &)> op) const        { return std::none_of(cbegin(), cend(), op);                     }
+
+    // Replace
+    //---------------------------------
+    // The && versions (on temporaries) return the same storage by move
+    constexpr tvector & replace(const T &oldValue, const T &newValue) & {
+        std::replace(begin(), end(), oldValue, newValue);
+        return *this;
+    }
+    constexpr tvector   replace(const T &oldValue, const T &newValue) &&    { return std::move(replace(oldValue, newValue));                }
+
+    constexpr tvector & replace_if(std::function<bool(const T &)> op, const T &newValue) & {
+        std::replace_if(begin(), end(), op, newValue);
+        return *this;
+    }
+    constexpr tvector   replace_if(std::function<bool(const T &)> op, const T &newValue) && {
+        return std::move(replace_if(op, newValue));
+    }
+
+    constexpr tvector & replace_if(std::function<bool(const T &)> op, std::function<T(const T &)> newValue) & {
+        for (auto current = begin(); current != end(); ++current) {
+            if (op(*current)) {
+                *current = newValue(*current);
+            }
+        }
+        return *this;
+    }
+    constexpr tvector   replace_if(std::function<bool(const T &)> op, std::function<T(const T &)> newValue) && {
+        return std::move(replace_if(op, newValue));
+    }
+
+    // Replace and copy
+    //---------------------------------
+    constexpr tvector & replace_copy(tvector &output, const T &oldValue, const T &newValue) {
+        std::replace_copy(cbegin(), cend(), std::back_inserter(output), oldValue, newValue);
+        return *this;
+    }
+
+    constexpr tvector & replace_copy_if(tvector &output, std::function<bool(const T &)> op, const T &newValue) {
+        std::replace_copy_if(cbegin(), cend(), std::back_inserter(output), op, newValue);
+        return *this;
+    }
+
+    constexpr tvector & replace_copy_if(tvector &output, std::function<bool(const T &)> op, std::function<T(const T &)> newValue) {
+        for (auto current = cbegin(); current != cend(); ++current) {
+            if (op(*current)) {
+                output.push_back(newValue(*current));
+            } else {
+                output.push_back(*current);
+            }
+        }
+        return *this;
+    }
+
+    // Copy
+    //---------------------------------
+    constexpr tvector & copy(tvector &output) {
+        output.reserve(size());
+        std::copy(cbegin(), cend(), std::back_inserter(output));
+        return *this;
+    }
+
+    constexpr const tvector & copy(tvector &output) const {
+        output.reserve(size());
+        std::copy(cbegin(), cend(), std::back_inserter(output));
+        return *this;
+    }
+
+    constexpr tvector & copy_if(tvector &output, std::function<bool(const T &)> op) {
+        TVECTOR_TRACE_SCOPE("copy_if", size(), -1);
+        std::copy_if(cbegin(), cend(), std::back_inserter(output), op);
+        return *this;
+    }
+
+    constexpr const tvector & copy_if(tvector &output, std::function<bool(const T &)> op) const {
+        TVECTOR_TRACE_SCOPE("copy_if", size(), -1);
+        std::copy_if(cbegin(), cend(), std::back_inserter(output), op);
+        return *this;
+    }
+
+    // Filter
+    //---------------------------------
+    constexpr tvector filter(std::function<bool(const T &)> op) & {
+        TVECTOR_TRACE_SCOPE("filter", size(), -1);
+        tvector output;
+        std::copy_if(cbegin(), cend(), std::back_inserter(output), op);
+        return output;
+    }
+
+    constexpr const tvector filter(std::function<bool(const T &)> op) const & {
+        TVECTOR_TRACE_SCOPE("filter", size(), -1);
+        tvector output;
+        std::copy_if(cbegin(), cend(), std::back_inserter(output), op);
+        return output;
+    }
+
+    // On a temporary the elements are filtered in place and its storage is returned (no allocation)
+    constexpr tvector filter(std::function<bool(const T &)> op) && {
+        TVECTOR_TRACE_SCOPE("filter", size(), -1);
+        erase(std::remove_if(begin(), end(), [&op](const T &value) { return !op(value); }), end());
+        return std::move(*this);
+    }
+
+    // Partition
+    //---------------------------------
+    // Moves the elements satisfying pred before the others and returns how many there are (the index of the
+    // first one that does not). partition does not allocate; stable_partition keeps the order inside both
+    // parts (std::stable_partition uses a temporary buffer when it can get one).
+    // partition_copy copies them, in order, to two outputs (random access iterators with room for them).
+    template <class Predicate>
+    size_type partition(Predicate pred) {
+        TVECTOR_TRACE_SCOPE("partition", size(), -1);
+        return size_type(std::partition(begin(), end(), pred) - begin());
+    }
+
+    template <class Predicate>
+    size_type stable_partition(Predicate pred) {
+        TVECTOR_TRACE_SCOPE("stable_partition", size(), -1);
+        return size_type(std::stable_partition(begin(), end(), pred) - begin());
+    }
+
+    template <class OutputTrue, class OutputFalse, class Predicate>
+    size_type partition_copy(OutputTrue firstTrue, OutputFalse firstFalse, Predicate pred) const {
+        TVECTOR_TRACE_SCOPE("partition_copy", size(), -1);
+        return size_type(std::partition_copy(cbegin(), cend(), firstTrue, firstFalse, pred).first - firstTrue);
+    }
+
+    // Defined in parallel_TVector.h. partition: every chunk is partitioned and the misplaced elements are swapped.
+    // stable_partition and partition_copy: the chunks are counted and then every element is moved to its place
+    // (types with a move that can throw use the sequential stable_partition).
+    template <class Predicate>
+    size_type partition(ExecutionPolicy policy, Predicate pred);
+    template <class Predicate>
+    size_type stable_partition(ExecutionPolicy policy, Predicate pred);
+    template <class OutputTrue, class OutputFalse, class Predicate>
+    size_type partition_copy(ExecutionPolicy policy, OutputTrue firstTrue, OutputFalse firstFalse, Predicate pred) const;
+
+    // For each
+    //---------------------------------
+    constexpr const tvector & for_each(std::function<void(const T &)> op) const {
+        TVECTOR_TRACE_SCOPE("for_each", size(), -1);
+        std::for_each(cbegin(), cend(), op);
+        return *this;
+    }
+    constexpr tvector & for_each(std::function<void(T &)> op) {
+        TVECTOR_TRACE_SCOPE("for_each", size(), -1);
+        std::for_each(begin(), end(), op);
+        return *this;
+    }
+
+    // op(index, element)
+    template <class Op>
+    const tvector & for_each_indexed(Op op) const {
+        TVECTOR_TRACE_SCOPE("for_each_indexed", size(), -1);
+        for (size_type i = 0; i < size(); ++i)
+            op(i, (*this)[i]);
+        return *this;
+    }
+    template <class Op>
+    tvector & for_each_indexed(Op op) {
+        TVECTOR_TRACE_SCOPE("for_each_indexed", size(), -1);
+        for (size_type i = 0; i < size(); ++i)
+            op(i, (*this)[i]);
+        return *this;
+    }
+
+    // With an execution policy the elements go in chunks of grain elements (0: about 8 chunks per thread and
+    // at least detail::kMinForEachGrain), handed out to the threads one at a time as they finish the previous one, so
+    // irregular costs per element balance. for_each_chunk calls op(first, last, firstIndex) once per chunk
+    // (a plain loop inside can be vectorized). op is called from several threads at the same time.
+    // Defined in parallel_TVector.h
+    template <class Op>
+    tvector & for_each(ExecutionPolicy policy, Op op, size_type grain = 0);
+    template <class Op>
+    const tvector & for_each(ExecutionPolicy policy, Op op, size_type grain = 0) const;
+    template <class Op>
+    tvector & for_each_indexed(ExecutionPolicy policy, Op op, size_type grain = 0);
+    template <class Op>
+    const tvector & for_each_indexed(ExecutionPolicy policy, Op op, size_type grain = 0) const;
+    template <class Op>
+    tvector & for_each_chunk(ExecutionPolicy policy, Op op, size_type grain = 0);
+    template <class Op>
+    const tvector & for_each_chunk(ExecutionPolicy policy, Op op, size_type grain = 0) const;
+
+    // Asynchronous
+    //---------------------------------
+    // They run on the worker pool of threads_TVector.h and return a TAsync (a std::future that can call
+    // back when ready, and be co_awaited with C++20). Lifetime of *this:
+    // - The & ones (sort_async, transform_async) modify *this: it must outlive the task and must not be
+    //   accessed until it is ready.
+    // - The const ones (reduce_async, filter_async) read *this: it must outlive the task and must not be
+    //   modified until it is ready.
+    // - The && ones take the elements (std::move(v).sort_async()) and give them back in the result, so
+    //   nothing is shared with the caller.
+    // Defined in async_TVector.h
+    template <class Less = std::less<T>>
+    TAsync<void>    sort_async(Less less = Less {}) &;
+    template <class Less = std::less<T>>
+    TAsync<tvector> sort_async(Less less = Less {}) &&;
+    template <class UnaryOperation>
+    TAsync<void>    transform_async(UnaryOperation op) &;
+    template <class UnaryOperation>
+    TAsync<tvector> transform_async(UnaryOperation op) &&;
+    template <class U, class BinaryOperation>
+    TAsync<U>       reduce_async(U init, BinaryOperation op) const;
+    template <class Predicate>
+    TAsync<tvector> filter_async(Predicate pred) const &;
+    template <class Predicate>
+    TAsync<tvector> filter_async(Predicate pred) &&;
+
+    // Sort
+    //---------------------------------
+    constexpr tvector & sort() &                                            { TVECTOR_TRACE_SCOPE("sort", size(), -1); std::sort(begin(), end()); return *this;                    }
+    constexpr tvector & sort(FuncLess less) &                               { TVECTOR_TRACE_SCOPE("sort", size(), -1); std::sort(begin(), end(), less); return *this;              }
+    constexpr tvector   sort() &&                                           { return std::move(sort());                                     }
+    constexpr tvector   sort(FuncLess less) &&                              { return std::move(sort(less));                                 }
+
+    constexpr tvector & stable_sort() &                                     { TVECTOR_TRACE_SCOPE("stable_sort", size(), -1); std::stable_sort(begin(), end()); return *this;       }
+    constexpr tvector & stable_sort(FuncLess less) &                        { TVECTOR_TRACE_SCOPE("stable_sort", size(), -1); std::stable_sort(begin(), end(), less); return *this; }
+    constexpr tvector   stable_sort() &&                                    { return std::move(stable_sort());                              }
+    constexpr tvector   stable_sort(FuncLess less) &&                       { return std::move(stable_sort(less));                          }
+
+    // Only the first min(k, size()) elements are sorted: the k smallest ones. O(n log k)
+    constexpr tvector & partial_sort(size_type k) &                         { TVECTOR_TRACE_SCOPE("partial_sort", size(), -1); std::partial_sort(begin(), begin() + std::min(k, size()), end()); return *this;       }
+    constexpr tvector & partial_sort(size_type k, FuncLess less) &          { TVECTOR_TRACE_SCOPE("partial_sort", size(), -1); std::partial_sort(begin(), begin() + std::min(k, size()), end(), less); return *this; }
+    constexpr tvector   partial_sort(size_type k) &&                        { return std::move(partial_sort(k));                            }
+    constexpr tvector   partial_sort(size_type k, FuncLess less) &&         { return std::move(partial_sort(k, less));                      }
+
+    // Puts in idx the element that would be there if sorted, with the smaller ones before it and the bigger ones after. O(n)
+    // Negative indices count from the end (-1 is the last). Out of range indices do nothing.
+    constexpr tvector & nth_element(ptrdiff idx) &                          { TVECTOR_TRACE_SCOPE("nth_element", size(), -1); auto nth = index_it(idx); if (nth != end()) std::nth_element(begin(), nth, end()); return *this;       }
+    constexpr tvector & nth_element(ptrdiff idx, FuncLess less) &           { TVECTOR_TRACE_SCOPE("nth_element", size(), -1); auto nth = index_it(idx); if (nth != end()) std::nth_element(begin(), nth, end(), less); return *this; }
+    constexpr tvector   nth_element(ptrdiff idx) &&                         { return std::move(nth_element(idx));                           }
+    constexpr tvector   nth_element(ptrdiff idx, FuncLess less) &&          { return std::move(nth_element(idx, less));                     }
+
+    // Middle element once sorted (the lower one for even sizes), or T {} if empty. O(n)
+    // Works on a copy: use nth_element((size() - 1) / 2) to do it in place.
+    T median() const                                                        { return tvector(*this).nth_element(ptrdiff(size() - 1) / 2).middle_or_default(); }
+    T median(FuncLess less) const                                           { return tvector(*this).nth_element(ptrdiff(size() - 1) / 2, less).middle_or_default(); }
+
+    // The k largest elements (by less), from the largest down. The vector is not modified.
+    // Small k use a bounded heap: O(n log k) time and O(k) memory.
+    // Defined in sort_TVector.h (the one with an execution policy, selecting per chunk in parallel, in parallel_TVector.h)
+    template <class Less = std::less<T>>
+    tvector top_k(size_type k, Less less = Less {}) const;
+    template <class Less = std::less<T>>
+    tvector top_k(ExecutionPolicy policy, size_type k, Less less = Less {}) const;
+
+  protected:
+    constexpr iterator index_it(ptrdiff idx) {
+        if (idx < 0)
+            idx += ptrdiff(size());
+        return (idx >= 0 && idx < ptrdiff(size())) ? begin() + idx : end();
+    }
+
+    T middle_or_default() const                                             { return empty() ? T {} : (*this)[(size() - 1) / 2];   }
+
+  public:
+    // Sorts by key(element), computing each key only once (decorate-sort-undecorate).
+    // Integer and float/double keys are radix sorted. stable_sort_by keeps the order of equal keys.
+    // Defined in sort_TVector.h
+    template <class KeyFn>
+    tvector & sort_by(KeyFn keyFn) &;
+    template <class KeyFn>
+    tvector   sort_by(KeyFn keyFn) &&                                       { return std::move(sort_by(keyFn));                             }
+
+    template <class KeyFn>
+    tvector & stable_sort_by(KeyFn keyFn) &;
+    template <class KeyFn>
+    tvector   stable_sort_by(KeyFn keyFn) &&                                { return std::move(stable_sort_by(keyFn));                      }
+
+    // Indices that sort the vector (stable): this[result[0]] <= this[result[1]] <= ...
+    // Integer vectors with the default less, and argsort_by with integer or float/double keys, are radix sorted.
+    // Defined in sort_TVector.h (the one with an execution policy in algorithm_TVector.h)
+    template <class Index = size_t, class Less = std::less<T>>
+    TVector<Index> argsort(Less less = Less {}) const;
+    template <class Index = size_t, class Less = std::less<T>>
+    TVector<Index> argsort(ExecutionPolicy policy, Less less = Less {}) const;
+    template <class Index = size_t, class KeyFn>
+    TVector<Index> argsort_by(KeyFn keyFn) const;
+
+    // Reorders in place so that this[i] = previous this[perm[i]] (perm as returned by argsort).
+    // Follows the cycles of the permutation: one bit of extra memory per element.
+    // Defined in sort_TVector.h
+    template <class Index, class IndexAllocator>
+    tvector & apply_permutation(const std::vector<Index, IndexAllocator> &perm) &;
+    template <class Index, class IndexAllocator>
+    tvector   apply_permutation(const std::vector<Index, IndexAllocator> &perm) && { return std::move(apply_permutation(perm));           }
+
+    constexpr bool is_sorted() const                                        { return std::is_sorted(cbegin(), cend());              }
+    constexpr bool is_sorted(FuncLess less) const                           { return std::is_sorted(cbegin(), cend(), less);        }
+
+    // Search on sorted vectors (branchless binary searches; equality is !less(value, element) after lower_bound)
+    template <class Less = std::less<T>>
+    constexpr citer lower_bound(const T &value, Less less = Less {}) const  { return detail::branchlessBound(cbegin(), size(), value, detail::LowerBefore<Less> { less }); }
+    template <class Less = std::less<T>>
+    constexpr iter  lower_bound(const T &value, Less less = Less {})        { return detail::branchlessBound( begin(), size(), value, detail::LowerBefore<Less> { less }); }
+    template <class Less = std::less<T>>
+    constexpr citer upper_bound(const T &value, Less less = Less {}) const  { return detail::branchlessBound(cbegin(), size(), value, detail::UpperBefore<Less> { less }); }
+    template <class Less = std::less<T>>
+    constexpr iter  upper_bound(const T &value, Less less = Less {})        { return detail::branchlessBound( begin(), size(), value, detail::UpperBefore<Less> { less }); }
+
+    template <class Less = std::less<T>>
+    constexpr std::pair<citer, citer> equal_range(const T &value, Less less = Less {}) const {
+        auto first = lower_bound(value, less);
+        return { first, detail::branchlessBound(first, size_t(cend() - first), value, detail::UpperBefore<Less> { less }) };
+    }
+    template <class Less = std::less<T>>
+    constexpr std::pair< iter,  iter> equal_range(const T &value, Less less = Less {}) {
+        auto first = lower_bound(value, less);
+        return { first, detail::branchlessBound(first, size_t(end() - first), value, detail::UpperBefore<Less> { less }) };
+    }
+
+    constexpr bool binary_search(const T &value) const                      { return binary_search_it(value) != cend();             }
+    constexpr bool binary_search(const T &value, FuncLess less) const       { return binary_search_it(value, less) != cend();       }
+
+    constexpr citer binary_search_it(const T &value) const                  { return binary_search_it(value, std::less<T> {});      }
+    constexpr citer binary_search_it(const T &value, FuncLess less) const   { return binary_search_it<FuncLess>(value, less);       }
+    template <class Less>
+    constexpr citer binary_search_it(const T &value, Less less) const {
+        auto it = lower_bound(value, less);
+        return (it != cend() && !less(value, *it)) ? it : cend();
+    }
+
+    // Index for many lookups on a big sorted vector that does not change (implicit B+ tree, ~n / 15 extra elements).
+    // Lookups return positions in this vector, that must not be modified while the index is used.
+    // Defined in search_TVector.h
+    template <class Less = std::less<T>>
+    TSearchIndex<T, Less> build_search_index(Less less = Less {}) const;
+
+    // Many searches at once: output[i] is the lower_bound position of queries[i] (size() if none), or if it was found.
+    // The searches of a batch of queries are interleaved to overlap their cache misses.
+    // Queries is a container (size() and operator[]) and Output a random access iterator.
+    // Defined in search_TVector.h (the ones with an execution policy, splitting the queries, in parallel_TVector.h)
+    template <class Queries, class Output, class Less = std::less<T>>
+    const tvector & lower_bound_many(const Queries &queries, Output firstOutput, Less less = Less {}) const;
+    template <class Queries, class Output, class Less = std::less<T>>
+    const tvector & lower_bound_many(ExecutionPolicy policy, const Queries &queries, Output firstOutput, Less less = Less {}) const;
+    template <class Queries, class Output, class Less = std::less<T>>
+    const tvector & binary_search_many(const Queries &queries, Output firstOutput, Less less = Less {}) const;
+    template <class Queries, class Output, class Less = std::less<T>>
+    const tvector & binary_search_many(ExecutionPolicy policy, const Queries &queries, Output firstOutput, Less less = Less {}) const;
+
+    // Set operations
+    //---------------------------------
+    // Both vectors must be sorted by less. Duplicates follow std::set_* (multiset semantics).
+    // The results are reserved up front. The *_with variants modify the vector in place.
+    // Intersections use exponential (galloping) search when one side is much smaller than the other.
+    // Defined in set_TVector.h
+    template <class Less = std::less<T>>
+    tvector set_union(const vector &other, Less less = Less {}) const;
+    template <class Less = std::less<T>>
+    tvector set_intersection(const vector &other, Less less = Less {}) const;
+    template <class Less = std::less<T>>
+    tvector set_difference(const vector &other, Less less = Less {}) const;
+    template <class Less = std::less<T>>
+    tvector set_symmetric_difference(const vector &other, Less less = Less {}) const;
+
+    // Size of the intersection, without allocating
+    template <class Less = std::less<T>>
+    size_type intersect_count(const vector &other, Less less = Less {}) const;
+
+    template <class Less = std::less<T>>
+    tvector & set_union_with(const vector &other, Less less = Less {}) &;
+    template <class Less = std::less<T>>
+    tvector & set_intersection_with(const vector &other, Less less = Less {}) &;
+    template <class Less = std::less<T>>
+    tvector & set_difference_with(const vector &other, Less less = Less {}) &;
+    template <class Less = std::less<T>>
+    tvector & set_symmetric_difference_with(const vector &other, Less less = Less {}) &;
+    template <class Less = std::less<T>>
+    tvector   set_union_with(const vector &other, Less less = Less {}) &&  { return std::move(set_union_with(other, less));            }
+    template <class Less = std::less<T>>
+    tvector   set_intersection_with(const vector &other, Less less = Less {}) && { return std::move(set_intersection_with(other, less)); }
+    template <class Less = std::less<T>>
+    tvector   set_difference_with(const vector &other, Less less = Less {}) && { return std::move(set_difference_with(other, less));  }
+    template <class Less = std::less<T>>
+    tvector   set_symmetric_difference_with(const vector &other, Less less = Less {}) && { return std::move(set_symmetric_difference_with(other, less)); }
+
+    // Merges many sorted vectors into one (k-way merge with a loser tree), reserved up front.
+    // Stable: equal elements keep the order of the runs. runs is any container of vectors of T.
+    // Defined in set_TVector.h (the one with an execution policy in parallel_TVector.h)
+    template <class Runs, class Less = std::less<T>>
+    static tvector merge_sorted(const Runs &runs, Less less = Less {});
+    // Splits the output by value ranges (splitters sampled from the runs) and merges them in parallel.
+    // T must be default constructible.
+    template <class Runs, class Less = std::less<T>>
+    static tvector merge_sorted(ExecutionPolicy policy, const Runs &runs, Less less = Less {});
+
+    // Grouping by key
+    //---------------------------------
+    // keyFn(element) is computed once per element. Keys are grouped with an open addressing hash table
+    // (Hash, by default std::hash, and operator ==). Groups come in order of first appearance.
+    // Defined in group_TVector.h (the ones with an execution policy, with a table per thread, in parallel_TVector.h)
+    template <class KeyFn>
+    using KeyOf = typename std::decay<decltype(std::declval<KeyFn &>()(std::declval<const T &>()))>::type;
+
+    // Histogram: (key, number of elements)
+    template <class KeyFn, class Hash = detail::DefaultHash>
+    TVector<std::pair<KeyOf<KeyFn>, size_t>> count_by(KeyFn keyFn, Hash hash = Hash {}) const;
+    template <class KeyFn, class Hash = detail::DefaultHash>
+    TVector<std::pair<KeyOf<KeyFn>, size_t>> count_by(ExecutionPolicy policy, KeyFn keyFn, Hash hash = Hash {}) const;
+
+    // (key, op(...op(op(init, e0), e1)..., en)) for the elements of each key, in order
+    template <class KeyFn, class U, class Op, class Hash = detail::DefaultHash>
+    TVector<std::pair<KeyOf<KeyFn>, U>> aggregate_by(KeyFn keyFn, U init, Op op, Hash hash = Hash {}) const;
+    // Each thread aggregates a chunk, and the chunks are combined with combine(U, U) in order
+    template <class KeyFn, class U, class Op, class Combine, class Hash = detail::DefaultHash>
+    TVector<std::pair<KeyOf<KeyFn>, U>> aggregate_by(ExecutionPolicy policy, KeyFn keyFn, U init, Op op, Combine combine, Hash hash = Hash {}) const;
+
+    // The elements grouped contiguously (CSR), keeping their order inside each group
+    template <class KeyFn, class Hash = detail::DefaultHash>
+    TGroups<KeyOf<KeyFn>, T> group_by(KeyFn keyFn, Hash hash = Hash {}) const;
+
+    // Unique
+    //---------------------------------
+    constexpr tvector & unique() &                                          { erase(std::unique(begin(), end()), end()); return *this; }
+    constexpr tvector   unique() &&                                         { return std::move(unique());                                   }
+
+    // Reverse
+    //---------------------------------
+    constexpr tvector & reverse() &                                         { std::reverse(begin(), end()); return *this;           }
+    constexpr tvector   reverse() &&                                        { return std::move(reverse());                          }
+
+    // Rotate
+    //---------------------------------
+    constexpr tvector & rotate(ptrdiff idx) {
+        if (idx > 0)
+            std::rotate(begin(), begin() + idx, end());
+        else if (idx < 0)
+            std::rotate(rbegin(), rbegin() - idx, rend());
+
+        return *this;
+    }
+
+    // Shuffle
+    //---------------------------------
+    // Without an engine a per thread Xoshiro256 is used (see defaultRandomEngine).
+    // Any UniformRandomBitGenerator can be used (Xoshiro256, std::mt19937_64, ...).
+    // Defined in random_TVector.h
+    tvector & shuffle();
+
+    template <class Engine>
+    tvector & shuffle(Engine &&g);
+
+    // Reproducible (parallel) shuffle: the result only depends on seed, numThreads and size().
+    // - seq / unseq: Fisher-Yates on a single thread.
+    // - par / par_unseq / automatic: MergeShuffle using numThreads threads (0 = hardware threads).
+    //   Small vectors use less threads to keep at least kMinShuffleBlock elements per thread.
+    // Defined in parallel_TVector.h
+    tvector & shuffle(ExecutionPolicy policy, uint64_t seed, size_type numThreads = 0);
+    tvector & shuffle(ExecutionPolicy policy);
+
+    static constexpr size_type kMinShuffleBlock = 32 * 1024;
+
+    // Only the first k elements are shuffled: they become a random sample, in random order, of the whole vector. O(k)
+    // Defined in random_TVector.h
+    tvector & partial_shuffle(size_type k);
+
+    template <class Engine>
+    tvector & partial_shuffle(size_type k, Engine &&g);
+
+    // Returns min(k, size()) different elements, in random order, without modifying the vector. O(k)
+    // Defined in random_TVector.h
+    tvector sample(size_type k) const;
+
+    template <class Engine>
+    tvector sample(size_type k, Engine &&g) const;
+
+    // Min/Max
+    //---------------------------------
+  protected:
+    enum class MinMax { Min, Max};
+
+    // To avoid repeating the code
+    template <typename Iterator, typename FuncLess = std::less<T>>
+    const T &find_extremum(Iterator begin, Iterator end, const MinMax &minmax, const FuncLess &less = FuncLess {}) const {
+        if (empty() == false) {
+            return (minmax == MinMax::Min) ? *std::min_element(begin, end, less) : *std::max_element(begin, end, less);
+
+        }
+
+        static const T empty {};
+        return empty;
+    }
+
+  public:
+    constexpr const T & min() const                                          { return find_extremum(cbegin(), cend(), MinMax::Min);                 }
+    constexpr       T & min()                                                { return const_cast<T &>(find_extremum(begin(), end(), MinMax::Min));  }
+
+    constexpr const T & min(FuncLess less) const                             { return find_extremum(cbegin(), cend(), MinMax::Min, less);           }
+    constexpr       T & min(FuncLess less)                                   { return const_cast<T &>(find_extremum(begin(), end(), MinMax::Min, less));    }
+
+    constexpr const T & max() const                                          { return find_extremum(cbegin(), cend(), MinMax::Max);                 }
+    constexpr       T & max()                                                { return const_cast<T &>(find_extremum(begin(), end(), MinMax::Max));  }
+
+    constexpr const T & max(FuncLess less) const                             { return find_extremum(cbegin(), cend(), MinMax::Max, less);           }
+    constexpr       T & max(FuncLess less)                                   { return const_cast<T &>(find_extremum(begin(), end(), MinMax::Max, less));    }
+
+    // TODO: Try to do not repeat this code
+    pair minmax(FuncLess less = std::less<T> {}) {
+        if (empty() == false) {
+            auto p = std::minmax_element(begin(), end(), less);
+            return std::make_pair(std::ref(*p.first), std::ref(*p.second));
+        }
+
+        static T empty {};
+        return std::make_pair(std::ref(empty), std::ref(empty));
+    }
+    cpair minmax(FuncLess less = std::less<T> {}) const {
+        if (empty() == false) {
+            auto p = std::minmax_element(cbegin(), cend(), less);
+            return std::make_pair(std::cref(*p.first), std::cref(*p.second));
+        }
+
+        static const T empty {};
+        return std::make_pair(std::cref(empty), std::cref(empty));
+    }
+
+    // Min/Max returning iterators
+    //---------------------------------
+    constexpr const_iterator min_it() const                                 { return std::min_element(cbegin(), cend());            }
+    constexpr iterator       min_it()                                       { return std::min_element( begin(),  end());            }
+    constexpr const_iterator min_it(FuncLess less) const                    { return std::min_element(cbegin(), cend(), less);      }
+    constexpr iterator       min_it(FuncLess less)                          { return std::min_element( begin(),  end(), less);      }
+
+    constexpr const_iterator max_it() const                                 { return std::max_element(cbegin(), cend());            }
+    constexpr iterator       max_it()                                       { return std::max_element( begin(),  end());            }
+    constexpr const_iterator max_it(FuncLess less) const                    { return std::max_element(cbegin(), cend(), less);      }
+    constexpr iterator       max_it(FuncLess less)                          { return std::max_element( begin(),  end(), less);      }
+
+    constexpr std::pair<citer, citer> minmax_it() const                     { return std::minmax_element(cbegin(), cend());         }
+    constexpr std::pair< iter,  iter> minmax_it()                           { return std::minmax_element( begin(),  end());         }
+    constexpr std::pair<citer, citer> minmax_it(FuncLess less) const        { return std::minmax_element(cbegin(), cend(), less);   }
+    constexpr std::pair< iter,  iter> minmax_it(FuncLess less)              { return std::minmax_element( begin(),  end(), less);   }
+
+    // Transform
+    //---------------------------------
+    // Transforms each component of the vector in place using the op function.
+    // this[i] = op(this[i])
+    // Usually: std::function<T(const T &)>
+    // The && version (on temporaries) returns the same storage by move.
+    //---------------------------------
+    template <class UnaryOperation>
+    constexpr tvector & transform(UnaryOperation op) & {
+        TVECTOR_TRACE_SCOPE("transform", size(), -1);
+        std::transform(cbegin(), cend(), begin(), op);
+        return *this;
+    }
+    template <class UnaryOperation>
+    constexpr tvector   transform(UnaryOperation op) &&                     { return std::move(transform(op));                              }
+
+    // Transforms and stores each component of the vector using the op function into the output iterator.
+    // output[i] = op(this[i])
+    // Usually: std::function<O(const T &)>
+    //---------------------------------
+    template <class Output, class UnaryOperation>
+    constexpr const tvector & transform(Output firstOutput, UnaryOperation op) const {
+        TVECTOR_TRACE_SCOPE("transform", size(), -1);
+        std::transform(cbegin(), cend(), firstOutput, op);
+        return *this;
+    }
+    template <class Output, class UnaryOperation>
+    constexpr tvector & transform(Output firstOutput, UnaryOperation op) {
+        TVECTOR_TRACE_SCOPE("transform", size(), -1);
+        std::transform(cbegin(), cend(), firstOutput, op);
+        return *this;
+    }
+
+    // Execution policy must be ne of:
+    //   - std::execution::seq: execution may not be parallelized.
+    //   - std::execution::par: execution may be parallelized.
+    //   - std::execution::par_unseq: execution may be parallelized, vectorized, or migrated across threads.
+    //   - std::execution::unseq: execution may be vectorized. [C++20]
+    //   - automatic: seq or par depending on the number of elements (see ExecutionThresholds).
+    // relativeCost is the cost of op per element that automatic weighs the count by (1 = an integer addition, see resolvePolicy).
+
+    template <class Output, class UnaryOperation>
+    constexpr const tvector & transform(ExecutionPolicy policy, Output firstOutput, UnaryOperation op, double relativeCost = 1.0) const {
+        unconst().transform(policy, firstOutput, op, relativeCost);
+        return *this;
+    }
+    template <class Output, class UnaryOperation>
+    tvector & transform(ExecutionPolicy policy, Output firstOutput, UnaryOperation op, double relativeCost = 1.0);
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    // Compile-time policy: execution::seq, par, par_unseq, unseq or automatic
+    template <ExecutionPolicy Policy, class Output, class UnaryOperation>
+    constexpr const tvector & transform(execution::policy_tag<Policy> policy, Output firstOutput, UnaryOperation op) const {
+        unconst().transform(policy, firstOutput, op);
+        return *this;
+    }
+    template <ExecutionPolicy Policy, class Output, class UnaryOperation>
+    tvector & transform(execution::policy_tag<Policy> policy, Output firstOutput, UnaryOperation op);
+#endif
+
+    // Transforms and stores in output each component of the vector combined with the firstInput iterator elements using the op function.
+    // output[i] = op(this[i], input[i])
+    // Usually: std::function<O(const T &, const I &)>
+    //---------------------------------
+    template <class Input, class Output, class BinaryOperation>
+    constexpr const tvector & transform(Input firstInput, Output firstOutput, BinaryOperation op) const {
+        TVECTOR_TRACE_SCOPE("transform", size(), -1);
+        std::transform(cbegin(), cend(), firstInput, firstOutput, op);
+        return *this;
+    }
+    template <class Input, class Output, class BinaryOperation>
+    constexpr tvector & transform(Input firstInput, Output firstOutput, BinaryOperation op) {
+        TVECTOR_TRACE_SCOPE("transform", size(), -1);
+        std::transform(cbegin(), cend(), firstInput, firstOutput, op);
+        return *this;
+    }
+
+    // Execution policy must be ne of:
+    //   - std::execution::seq: execution may not be parallelized.
+    //   - std::execution::par: execution may be parallelized.
+    //   - std::execution::par_unseq: execution may be parallelized, vectorized, or migrated across threads.
+    //   - std::execution::unseq: execution may be vectorized. [C++20]
+    //   - automatic: seq or par depending on the number of elements (see ExecutionThresholds).
+    // relativeCost is the cost of op per element that automatic weighs the count by (1 = an integer addition, see resolvePolicy).
+    // An arithmetic op is the relativeCost of the unary transform above (transform(policy, output, op, 16)).
+    template <class Input, class Output, class BinaryOperation, class = typename std::enable_if<!std::is_arithmetic<BinaryOperation>::value>::type>
+    constexpr const tvector & transform(ExecutionPolicy policy, Input firstInput, Output firstOutput, BinaryOperation op, double relativeCost = 1.0) const {
+        unconst().transform(policy, firstInput, firstOutput, op, relativeCost);
+        return *this;
+    }
+    template <class Input, class Output, class BinaryOperation, class = typename std::enable_if<!std::is_arithmetic<BinaryOperation>::value>::type>
+    tvector & transform(ExecutionPolicy policy, Input firstInput, Output firstOutput, BinaryOperation op, double relativeCost = 1.0);
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    // Compile-time policy: execution::seq, par, par_unseq, unseq or automatic
+    template <ExecutionPolicy Policy, class Input, class Output, class BinaryOperation>
+    constexpr const tvector & transform(execution::policy_tag<Policy> policy, Input firstInput, Output firstOutput, BinaryOperation op) const {
+        unconst().transform(policy, firstInput, firstOutput, op);
+        return *this;
+    }
+    template <ExecutionPolicy Policy, class Input, class Output, class BinaryOperation>
+    tvector & transform(execution::policy_tag<Policy> policy, Input firstInput, Output firstOutput, BinaryOperation op);
+#endif
+
+    // Transforms and stores each component of the vector using the op function into the output.
+    // Output will be resized to the same size as this vector.
+    // output[i] = op(this[i])
+    // Usually: std::function<O(const T &)>
+    //---------------------------------
+    template <template <typename...> class OutputClass, typename... Args, class UnaryOperation>
+    constexpr const tvector & transform(OutputClass<Args...> &output, UnaryOperation op) const {
+        if (output.size() < size())
+            output.resize(size());
+
+        TVECTOR_TRACE_SCOPE("transform", size(), -1);
+        std::transform(cbegin(), cend(), output.begin(), op);
+        return *this;
+    }
+
+    template <template <typename...> class OutputClass, typename... Args, class UnaryOperation>
+    constexpr tvector & transform(OutputClass<Args...> &output, UnaryOperation op) {
+        if (output.size() < size())
+            output.resize(size());
+
+        TVECTOR_TRACE_SCOPE("transform", size(), -1);
+        std::transform(cbegin(), cend(), output.begin(), op);
+        return *this;
+    }
+
+    // Execution policy must be ne of:
+    //   - std::execution::seq: execution may not be parallelized.
+    //   - std::execution::par: execution may be parallelized.
+    //   - std::execution::par_unseq: execution may be parallelized, vectorized, or migrated across threads.
+    //   - std::execution::unseq: execution may be vectorized. [C++20]
+    //   - automatic: seq or par depending on the number of elements (see ExecutionThresholds).
+    // relativeCost is the cost of op per element that automatic weighs the count by (1 = an integer addition, see resolvePolicy).
+    template <template <typename...> class OutputClass, typename... Args, class UnaryOperation>
+    constexpr const tvector & transform(ExecutionPolicy policy, OutputClass<Args...> &output, UnaryOperation op, double relativeCost = 1.0) const {
+        unconst().transform(policy, output, op, relativeCost);
+        return *this;
+    }
+
+    template <template <typename...> class OutputClass, typename... Args, class UnaryOperation>
+    tvector & transform(ExecutionPolicy policy, OutputClass<Args...> &output, UnaryOperation op, double relativeCost = 1.0);
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    // Compile-time policy: execution::seq, par, par_unseq, unseq or automatic
+    template <ExecutionPolicy Policy, template <typename...> class OutputClass, typename... Args, class UnaryOperation,
+              class = decltype(std::declval<OutputClass<Args...> &>().resize(size_t()))>  // Containers only (not lvalue iterators)
+    constexpr const tvector & transform(execution::policy_tag<Policy> policy, OutputClass<Args...> &output, UnaryOperation op) const {
+        unconst().transform(policy, output, op);
+        return *this;
+    }
+    template <ExecutionPolicy Policy, template <typename...> class OutputClass, typename... Args, class UnaryOperation,
+              class = decltype(std::declval<OutputClass<Args...> &>().resize(size_t()))>  // Containers only (not lvalue iterators)
+    tvector & transform(execution::policy_tag<Policy> policy, OutputClass<Args...> &output, UnaryOperation op);
+#endif
+
+    // Accumulate
+    //---------------------------------
+    // The order of operations are left to right
+    template <class U, class BinaryOperation>
+    constexpr U accumulate(U init, BinaryOperation op) const {
+        TVECTOR_TRACE_SCOPE("accumulate", size(), -1);
+        return std::accumulate(cbegin(), cend(), init, op);
+    }
+
+
+    // Scans (prefix sums)
+    //---------------------------------
+    // inclusive_scan:           this[i] = this[0] op this[1] op ... op this[i]
+    // exclusive_scan:           this[i] = init op this[0] op ... op this[i - 1]
+    // transform_inclusive_scan: this[i] = t(this[0]) op ... op t(this[i])
+    // These go left to right, so in place and to an output give the same values. The ones with firstOutput
+    // (a random access iterator) write there.
+    template <class BinaryOperation = std::plus<T>, class = detail::BinaryOpOf<BinaryOperation, T>>
+    tvector & inclusive_scan(BinaryOperation op = BinaryOperation {}) & {
+        TVECTOR_TRACE_SCOPE("inclusive_scan", size(), -1);
+        detail::Identity identity;
+        detail::inclusiveScan(data(), size(), data(), op, identity, static_cast<const T *>(nullptr));
+        return *this;
+    }
+    template <class BinaryOperation = std::plus<T>, class = detail::BinaryOpOf<BinaryOperation, T>>
+    tvector   inclusive_scan(BinaryOperation op = BinaryOperation {}) &&    { return std::move(inclusive_scan(op));                         }
+    template <class Output, class BinaryOperation = std::plus<T>, class = typename std::iterator_traits<Output>::iterator_category>
+    const tvector & inclusive_scan(Output firstOutput, BinaryOperation op = BinaryOperation {}) const {
+        TVECTOR_TRACE_SCOPE("inclusive_scan", size(), -1);
+        detail::Identity identity;
+        detail::inclusiveScan(cbegin(), size(), firstOutput, op, identity, static_cast<const T *>(nullptr));
+        return *this;
+    }
+
+    template <class U, class BinaryOperation = std::plus<T>, class = detail::BinaryOpOf<BinaryOperation, T>>
+    tvector & exclusive_scan(U init, BinaryOperation op = BinaryOperation {}) & {
+        TVECTOR_TRACE_SCOPE("exclusive_scan", size(), -1);
+        detail::Identity identity;
+        detail::exclusiveScan(data(), size(), data(), op, identity, T(init));
+        return *this;
+    }
+    template <class U, class BinaryOperation = std::plus<T>, class = detail::BinaryOpOf<BinaryOperation, T>>
+    tvector   exclusive_scan(U init, BinaryOperation op = BinaryOperation {}) && { return std::move(exclusive_scan(init, op));             }
+    template <class Output, class U, class BinaryOperation = std::plus<T>, class = typename std::iterator_traits<Output>::iterator_category>
+    const tvector & exclusive_scan(Output firstOutput, U init, BinaryOperation op = BinaryOperation {}) const {
+        TVECTOR_TRACE_SCOPE("exclusive_scan", size(), -1);
+        detail::Identity identity;
+        detail::exclusiveScan(cbegin(), size(), firstOutput, op, identity, init);
+        return *this;
+    }
+
+    template <class BinaryOperation, class UnaryOperation>
+    tvector & transform_inclusive_scan(BinaryOperation op, UnaryOperation transform) & {
+        TVECTOR_TRACE_SCOPE("transform_inclusive_scan", size(), -1);
+        detail::inclusiveScan(data(), size(), data(), op, transform, static_cast<const T *>(nullptr));
+        return *this;
+    }
+    template <class BinaryOperation, class UnaryOperation>
+    tvector   transform_inclusive_scan(BinaryOperation op, UnaryOperation transform) && { return std::move(transform_inclusive_scan(op, transform)); }
+    template <class Output, class BinaryOperation, class UnaryOperation>
+    const tvector & transform_inclusive_scan(Output firstOutput, BinaryOperation op, UnaryOperation transform) const {
+        using U = typename std::decay<decltype(transform(std::declval<const T &>()))>::type;
+
+        TVECTOR_TRACE_SCOPE("transform_inclusive_scan", size(), -1);
+        detail::inclusiveScan(cbegin(), size(), firstOutput, op, transform, static_cast<const U *>(nullptr));
+        return *this;
+    }
+
+    // Defined in parallel_TVector.h (two pass blocked scan: every chunk is reduced, the totals are scanned and
+    // every chunk is scanned again from the total before it). op must be associative: the grouping depends
+    // on the chunks. With a policy other than seq, inclusive float sums (in place or to an output, the same
+    // values) go 4 elements at a time (detail::inclusiveSumBlocks, plain scalar code); integer sums and other
+    // operations use the left to right loop in every chunk.
+    template <class BinaryOperation = std::plus<T>, class = detail::BinaryOpOf<BinaryOperation, T>>
+    tvector & inclusive_scan(ExecutionPolicy policy, BinaryOperation op = BinaryOperation {}) &;
+    template <class BinaryOperation = std::plus<T>, class = detail::BinaryOpOf<BinaryOperation, T>>
+    tvector   inclusive_scan(ExecutionPolicy policy, BinaryOperation op = BinaryOperation {}) && { return std::move(inclusive_scan(policy, op)); }
+    template <class Output, class BinaryOperation = std::plus<T>, class = typename std::iterator_traits<Output>::iterator_category>
+    const tvector & inclusive_scan(ExecutionPolicy policy, Output firstOutput, BinaryOperation op = BinaryOperation {}) const;
+
+    template <class U, class BinaryOperation = std::plus<T>, class = detail::BinaryOpOf<BinaryOperation, T>>
+    tvector & exclusive_scan(ExecutionPolicy policy, U init, BinaryOperation op = BinaryOperation {}) &;
+    template <class U, class BinaryOperation = std::plus<T>, class = detail::BinaryOpOf<BinaryOperation, T>>
+    tvector   exclusive_scan(ExecutionPolicy policy, U init, BinaryOperation op = BinaryOperation {}) && { return std::move(exclusive_scan(policy, init, op)); }
+    template <class Output, class U, class BinaryOperation = std::plus<T>, class = typename std::iterator_traits<Output>::iterator_category>
+    const tvector & exclusive_scan(ExecutionPolicy policy, Output firstOutput, U init, BinaryOperation op = BinaryOperation {}) const;
+
+    template <class BinaryOperation, class UnaryOperation>
+    tvector & transform_inclusive_scan(ExecutionPolicy policy, BinaryOperation op, UnaryOperation transform) &;
+    template <class BinaryOperation, class UnaryOperation>
+    tvector   transform_inclusive_scan(ExecutionPolicy policy, BinaryOperation op, UnaryOperation transform) && { return std::move(transform_inclusive_scan(policy, op, transform)); }
+    template <class Output, class BinaryOperation, class UnaryOperation>
+    const tvector & transform_inclusive_scan(ExecutionPolicy policy, Output firstOutput, BinaryOperation op, UnaryOperation transform) const;
+
+    // Reduce / transform_reduce
+    //---------------------------------
+    // The order of operations is not guaranteed
+    // Note: Requires that the BinaryOperation satisfy the commutative: "A op B == B op A" and
+    // associative: "(A op B) op C == A op (B op C)" properties
+    template <class U, class BinaryOperation>
+    constexpr U reduce(U init, BinaryOperation op) const {
+        TVECTOR_TRACE_SCOPE("reduce", size(), -1);
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+        return std::reduce(cbegin(), cend(), init, op);
+#else
+        return std::accumulate(cbegin(), cend(), init, op);
+#endif
+    }
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    template <class U, class BinaryReductionOp, class UnaryTransformOp>
+    constexpr U transform_reduce(U init, BinaryReductionOp reduce, UnaryTransformOp transform) const {
+        TVECTOR_TRACE_SCOPE("transform_reduce", size(), -1);
+        return std::transform_reduce(cbegin(), cend(), init, reduce, transform);
+    }
+#else
+    template<class U, typename BinaryReductionOp, typename UnaryTransformOp>
+    auto transform_reduce(U init, BinaryReductionOp reduce, UnaryTransformOp transform) {
+        TVECTOR_TRACE_SCOPE("transform_reduce", size(), -1);
+        return std::accumulate(cbegin(), cend(), init, [&](const auto& acc, const auto& val) {
+            return reduce(acc, transform(val));
+        });
+    }
+#endif
+
+    // The order of operations is not guaranteed
+    // Execution policy must be ne of:
+    //   - std::execution::seq: execution may not be parallelized.
+    //   - std::execution::par: execution may be parallelized.
+    //   - std::execution::par_unseq: execution may be parallelized, vectorized, or migrated across threads.
+    //   - std::execution::unseq: execution may be vectorized. [C++20]
+    //   - automatic: seq or par depending on the number of elements (see ExecutionThresholds).
+    // relativeCost is the cost of the operations per element that automatic weighs the count by (1 = an integer addition, see resolvePolicy).
+    template <class U, class BinaryOperation>
+    U reduce(ExecutionPolicy policy, U init, BinaryOperation op, double relativeCost = 1.0) const;
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    // Compile-time policy: execution::seq, par, par_unseq, unseq or automatic
+    template <ExecutionPolicy Policy, class U, class BinaryOperation>
+    U reduce(execution::policy_tag<Policy> policy, U init, BinaryOperation op) const;
+#endif
+
+    template <class U, class BinaryReductionOp, class UnaryTransformOp>
+    U transform_reduce(ExecutionPolicy policy, U init, BinaryReductionOp reduce, UnaryTransformOp transform, double relativeCost = 1.0) const;
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    // Compile-time policy: execution::seq, par, par_unseq, unseq or automatic
+    template <ExecutionPolicy Policy, class U, class BinaryReductionOp, class UnaryTransformOp>
+    U transform_reduce(execution::policy_tag<Policy> policy, U init, BinaryReductionOp reduce, UnaryTransformOp transform) const;
+#endif
+
+    // Cancellable
+    //---------------------------------
+    // The work goes in units of at most detail::kCancelGrain elements (on the threads of parallel_TVector.h
+    // unless the policy is seq or unseq) and every unit checks token first: once it is cancelled (or its deadline
+    // passes) the remaining units are skipped. They return whether every unit ran; if not, the output, or the
+    // vector for sort, is partially processed (sort leaves a permutation of the elements).
+    // The merges of sort are units too, so the last one (of the whole vector) is not interrupted.
+    // Defined in parallel_TVector.h
+    template <class Output, class UnaryOperation>
+    bool transform(ExecutionPolicy policy, Output firstOutput, UnaryOperation op, const TCancellationToken &token) const;
+    template <class Output, class UnaryOperation>
+    bool transform(ExecutionPolicy policy, Output firstOutput, UnaryOperation op, const TCancellationToken &token);
+
+    template <class U, class BinaryOperation>
+    TCancellable<U> reduce(ExecutionPolicy policy, U init, BinaryOperation op, const TCancellationToken &token) const;
+
+    template <class U, class BinaryReductionOp, class UnaryTransformOp>
+    TCancellable<U> transform_reduce(ExecutionPolicy policy, U init, BinaryReductionOp reduce, UnaryTransformOp transform, const TCancellationToken &token) const;
+
+    bool sort(ExecutionPolicy policy, const TCancellationToken &token)     { return sort(policy, std::less<T>(), token);                  }
+    template <class Less>
+    bool sort(ExecutionPolicy policy, Less less, const TCancellationToken &token);
+
+    template <class Predicate>
+    TCancellable<tvector> filter(ExecutionPolicy policy, Predicate pred, const TCancellationToken &token) const;
+
+protected:
+    constexpr iterator       correct(ptrdiff idx)                           { return (idx >= 0) ?  begin() + idx :  end() + idx + 1; }
+    constexpr const_iterator correct(ptrdiff idx) const                     { return (idx >= 0) ? cbegin() + idx : cend() + idx + 1; }
+    constexpr ptrdiff        correctIdx(ptrdiff idx) const                  { return (idx >= 0) ? idx : size() + idx + 1; }
+
+    constexpr iterator       correctInside(ptrdiff idx)                     { return (idx >= 0) ?  begin() + idx :  end() + idx; }
+    constexpr const_iterator correctInside(ptrdiff idx) const               { return (idx >= 0) ? cbegin() + idx : cend() + idx; }
+    constexpr ptrdiff        correctInsideIdx(ptrdiff idx) const            { return (idx >= 0) ? idx : size() + idx; }
+
+    // Avoid duplicate some functions
+    constexpr tvector &      unconst() const                                { return *const_cast<tvector *>(this); }
+};
+
+//-------------------------------------
+template <class T, class Allocator = std::allocator<T>>
+constexpr TVector<T, Allocator> &
+asTVector(std::vector<T, Allocator> &vec) {
+    //return *reinterpret_cast<TVector<T, Allocator> *>(&vec);
+    return static_cast<TVector<T, Allocator> &>(vec);
+}
+
+//-------------------------------------
+template <class T, class Allocator = std::allocator<T>>
+constexpr const TVector<T, Allocator> &
+asTVector(const std::vector<T, Allocator> &vec) {
+    //return *reinterpret_cast<const TVector<T, Allocator> *>(&vec);
+    return static_cast<const TVector<T, Allocator> &>(vec);
+}
+
+//-------------------------------------
+// Explicit instantiation for common element types.
+// TVector.cpp instantiates TVector<T> for them (library TVectorInstances, CMake option TVECTOR_BUILD_INSTANCES).
+// With TVECTOR_EXTERN_TEMPLATES (set for the users of that library) they are not instantiated again in every
+// translation unit, and the non template members defined in the other headers (shuffle(policy, seed), sample(k), ...)
+// can be used including only this header.
+//-------------------------------------
+#define TVECTOR_COMMON_TYPES(X)                                         \
+    X(char)     X(int8_t)   X(uint8_t)  X(int16_t)  X(uint16_t)         \
+    X(int32_t)  X(uint32_t) X(int64_t)  X(uint64_t) X(float)  X(double)
+
+#if defined(TVECTOR_EXTERN_TEMPLATES)
+    #define TVECTOR_EXTERN_TEMPLATE(type)   extern template class TVector<type>;
+    TVECTOR_COMMON_TYPES(TVECTOR_EXTERN_TEMPLATE)
+    #undef TVECTOR_EXTERN_TEMPLATE
+#endif
+
+} // end of namespace
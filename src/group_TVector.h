@@ -0,0 +1,214 @@
+#pragma once
+
+//-------------------------------------
+// TVector grouping by a computed key (declared in core_TVector.h): count_by, aggregate_by and group_by.
+// Keys go to an open addressing hash table (linear probing, at most half full) that maps each key to a
+// consecutive group id, so the results are flat vectors in order of first appearance instead of maps.
+// group_by returns the elements grouped contiguously (CSR): keys, offsets and the elements.
+//-------------------------------------
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "core_TVector.h"
+
+namespace MindShake {
+
+//-------------------------------------
+// Result of TVector::group_by: group g has key keys[g] and the elements items[offsets[g], offsets[g + 1])
+//-------------------------------------
+template <class Key, class T>
+struct TGroups {
+    TVector<Key>    keys;
+    TVector<size_t> offsets { 0 };
+    TVector<T>      items;
+
+    size_t      size() const                                                { return keys.size();                                           }
+    bool        empty() const                                               { return keys.empty();                                          }
+    size_t      group_size(size_t g) const                                  { return offsets[g + 1] - offsets[g];                           }
+    const T *   group_begin(size_t g) const                                 { return items.data() + offsets[g];                             }
+    const T *   group_end(size_t g) const                                   { return items.data() + offsets[g + 1];                         }
+};
+
+namespace detail {
+
+    //---------------------------------
+    constexpr uint32_t kNoGroup = uint32_t(-1);
+
+    // Slot of a GroupTable: the key itself when it is small and trivially copyable (one dependent load less
+    // per lookup), or 32 bits of its hash (to skip most of the comparisons through the key list).
+    template <class Key, bool Inline = std::is_trivially_copyable<Key>::value && std::is_default_constructible<Key>::value && (sizeof(Key) <= 16)>
+    struct GroupSlot {
+        uint32_t    tag   = 0;
+        uint32_t    group = kNoGroup;
+
+        void set(uint64_t hash, const Key &, uint32_t id)                   { tag = uint32_t(hash); group = id;                             }
+        template <class K>
+        bool matches(uint64_t hash, const K &key, const TVector<Key> &keys) const { return tag == uint32_t(hash) && keys[group] == key; }
+    };
+
+    template <class Key>
+    struct GroupSlot<Key, true> {
+        Key         key   {};
+        uint32_t    group = kNoGroup;
+
+        void set(uint64_t, const Key &value, uint32_t id)                   { key = value; group = id;                                      }
+        template <class K>
+        bool matches(uint64_t, const K &value, const TVector<Key> &) const  { return key == value;                                          }
+    };
+
+    //---------------------------------
+    // Key -> consecutive group id (less than 2^32 groups), with linear probing in a table at most half full.
+    // Fibonacci hashing: the high bits of hash * 2^64 / phi select the slot. It spreads strided integer keys
+    // (std::hash of integers is the identity) as well as a full mix, for one multiplication.
+    template <class Key, class Hash>
+    class GroupTable {
+    public:
+        explicit GroupTable(const Hash &hash) : mHash(hash), mSlots(size_t(1) << (64 - kFirstShift)) { }
+
+        // Id of the group of key, adding it when new
+        template <class K>
+        size_t id(K &&key) {
+            if ((mKeys.size() + 1) * 2 > mSlots.size())
+                rehash();
+
+            const uint64_t hash = uint64_t(mHash(key)) * 0x9e3779b97f4a7c15ull;
+            const size_t   mask = mSlots.size() - 1;
+            for (size_t pos = size_t(hash >> mShift);; pos = (pos + 1) & mask) {
+                Slot &slot = mSlots[pos];
+                if (slot.group == kNoGroup) {
+                    mKeys.push_back(std::forward<K>(key));
+                    slot.set(hash, mKeys.back(), uint32_t(mKeys.size() - 1));
+                    return slot.group;
+                }
+                if (slot.matches(hash, key, mKeys))
+                    return slot.group;
+            }
+        }
+
+        size_t          size() const                                        { return mKeys.size();                                          }
+        TVector<Key> &  keys()                                              { return mKeys;                                                 }
+
+    protected:
+        using Slot = GroupSlot<Key>;
+
+        static constexpr unsigned kFirstShift = 60;     // 16 slots
+
+        // Twice as big
+        void rehash() {
+            --mShift;
+            std::vector<Slot> slots(size_t(1) << (64 - mShift));
+            const size_t      mask = slots.size() - 1;
+            for (uint32_t group = 0; group < uint32_t(mKeys.size()); ++group) {
+                const uint64_t hash = uint64_t(mHash(mKeys[group])) * 0x9e3779b97f4a7c15ull;
+                size_t pos = size_t(hash >> mShift);
+                while (slots[pos].group != kNoGroup)
+                    pos = (pos + 1) & mask;
+                slots[pos].set(hash, mKeys[group], group);
+            }
+            mSlots.swap(slots);
+        }
+
+    protected:
+        Hash                mHash;
+        unsigned            mShift = kFirstShift;
+        std::vector<Slot>   mSlots;
+        TVector<Key>        mKeys;
+    };
+
+    //---------------------------------
+    // Aggregates [first, last) into table and values (values[id] is the accumulator of group id)
+    template <class Table, class Values, class T, class KeyFn, class U, class Op>
+    inline void
+    aggregateRange(const T *first, const T *last, KeyFn &keyFn, const U &init, Op &op, Table &table, Values &values) {
+        for (; first != last; ++first) {
+            const size_t id = table.id(keyFn(*first));
+            if (id == values.size())
+                values.push_back(init);
+            values[id] = op(std::move(values[id]), *first);
+        }
+    }
+
+    //---------------------------------
+    template <class Key, class U>
+    inline TVector<std::pair<Key, U>>
+    zipGroups(TVector<Key> &keys, TVector<U> &values) {
+        TVector<std::pair<Key, U>> result;
+        result.reserve(keys.size());
+        for (size_t g = 0; g < keys.size(); ++g)
+            result.emplace_back(std::move(keys[g]), std::move(values[g]));
+        return result;
+    }
+
+} // end of namespace detail
+
+// TVector members (declared in core_TVector.h)
+//-------------------------------------
+template <class T, class Allocator>
+template <class KeyFn, class Hash>
+TVector<std::pair<typename TVector<T, Allocator>::template KeyOf<KeyFn>, size_t>>
+TVector<T, Allocator>::count_by(KeyFn keyFn, Hash hash) const {
+    TVECTOR_TRACE_SCOPE("count_by", size(), -1);
+    detail::GroupTable<KeyOf<KeyFn>, Hash> table(hash);
+    TVector<size_type>                     counts;
+    for (const T &item : *this) {
+        const size_t id = table.id(keyFn(item));
+        if (id == counts.size())
+            counts.push_back(0);
+        ++counts[id];
+    }
+    return detail::zipGroups(table.keys(), counts);
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class KeyFn, class U, class Op, class Hash>
+TVector<std::pair<typename TVector<T, Allocator>::template KeyOf<KeyFn>, U>>
+TVector<T, Allocator>::aggregate_by(KeyFn keyFn, U init, Op op, Hash hash) const {
+    TVECTOR_TRACE_SCOPE("aggregate_by", size(), -1);
+    detail::GroupTable<KeyOf<KeyFn>, Hash> table(hash);
+    TVector<U>                             values;
+    detail::aggregateRange(data(), data() + size(), keyFn, init, op, table, values);
+    return detail::zipGroups(table.keys(), values);
+}
+
+//-------------------------------------
+// Two passes: group ids and counts, then every element is copied to its slot
+template <class T, class Allocator>
+template <class KeyFn, class Hash>
+TGroups<typename TVector<T, Allocator>::template KeyOf<KeyFn>, T>
+TVector<T, Allocator>::group_by(KeyFn keyFn, Hash hash) const {
+    TVECTOR_TRACE_SCOPE("group_by", size(), -1);
+    detail::GroupTable<KeyOf<KeyFn>, Hash> table(hash);
+    TVector<size_t>                        ids;
+    ids.reserve(size());
+    TGroups<KeyOf<KeyFn>, T>               groups;
+    for (const T &item : *this) {
+        const size_t id = table.id(keyFn(item));
+        if (id + 1 == groups.offsets.size())
+            groups.offsets.push_back(0);
+        ++groups.offsets[id + 1];
+        ids.push_back(id);
+    }
+
+    // Counts to offsets, and offsets[g] is the next free slot of g while copying
+    TVector<size_t> next(groups.offsets.size() - 1);
+    for (size_t g = 0; g < next.size(); ++g) {
+        groups.offsets[g + 1] += groups.offsets[g];
+        next[g] = groups.offsets[g];
+    }
+
+    std::vector<const T *> slots(size());
+    for (size_t i = 0; i < size(); ++i)
+        slots[next[ids[i]]++] = data() + i;
+    groups.items.reserve(size());
+    for (const T *item : slots)
+        groups.items.push_back(*item);
+
+    groups.keys = std::move(table.keys());
+    return groups;
+}
+
+} // end of namespace
@@ -0,0 +1,875 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "core_TVector.h"
+#include "threads_TVector.h"
+#include "random_TVector.h"
+#include "sort_TVector.h"
+#include "set_TVector.h"
+#include "search_TVector.h"
+#include "group_TVector.h"
+
+namespace MindShake {
+
+namespace detail {
+
+    //---------------------------------
+    // Minimum number of elements per chunk of the parallel algorithms: below it starting and joining
+    // the chunks costs more than the work they split.
+    constexpr size_t kMinParallelGrain = 32 * 1024;
+
+    //---------------------------------
+    // Two pass blocked scan of transform(input[i]) for i in [0, n): the totals of the chunks are computed in
+    // parallel (pass 1) and scanned, then scanChunk(first, last, carry) scans every chunk in parallel
+    // (pass 2) after the total of the chunks before it (after init, if any, for the first one).
+    template <class U, class Input, class Op, class Transform, class ScanChunk>
+    inline void
+    parallelScan(Input input, size_t n, size_t numChunks, Op &op, Transform &transform, const U *init, ScanChunk &&scanChunk) {
+        std::vector<U> carries(numChunks, U(transform(input[0])));
+        parallelFor(numChunks - 1, numChunks - 1, [&](size_t c) {
+            Op           chunkOp        = op;
+            Transform    chunkTransform = transform;
+            const size_t last           = n * (c + 1) / numChunks;
+            U            total          = chunkTransform(input[n * c / numChunks]);
+            for (size_t i = n * c / numChunks + 1; i < last; ++i)
+                total = chunkOp(std::move(total), chunkTransform(input[i]));
+            carries[c + 1] = std::move(total);
+        });
+
+        // carries[c]: everything before chunk c
+        for (size_t c = 1; c < numChunks; ++c) {
+            if (c > 1)
+                carries[c] = op(carries[c - 1], std::move(carries[c]));
+            else if (init != nullptr)
+                carries[c] = op(*init, std::move(carries[c]));
+        }
+
+        parallelFor(numChunks, numChunks, [&](size_t c) {
+            scanChunk(n * c / numChunks, n * (c + 1) / numChunks, (c > 0) ? &carries[c] : init);
+        });
+    }
+
+    //---------------------------------
+    // Independent, reproducible random stream for (seed, level, index)
+    inline Xoshiro256
+    randomStream(uint64_t seed, uint64_t level, uint64_t index) {
+        uint64_t state = seed;
+        state = splitmix64(state) ^ (level * 0xd1b54a32d192ed03ull);
+        state = splitmix64(state) ^ (index * 0x8cb92ba72f3d8dd7ull);
+        return Xoshiro256(splitmix64(state));
+    }
+
+    //---------------------------------
+    // MergeShuffle (Bacher, Bodini, Hollender & Lumbroso, 2015):
+    // Merges two shuffled adjacent ranges [first, middle) and [middle, last) into a shuffled range.
+    template <class Iterator>
+    inline void
+    mergeShuffled(Iterator first, Iterator middle, Iterator last, Xoshiro256 &g) {
+        using std::swap;
+
+        size_t   n    = size_t(last - first);
+        size_t   i    = 0;
+        size_t   j    = size_t(middle - first);
+        uint64_t bits = 0;
+        int      left = 0;
+
+        // Take elements from one side or the other flipping a coin
+        while (true) {
+            if (left == 0) {
+                bits = g();
+                left = 64;
+            }
+            bool fromRight = (bits & 1) != 0;
+            bits >>= 1;
+            --left;
+
+            if (fromRight) {
+                if (j == n)
+                    break;
+                swap(first[i], first[j]);
+                ++j;
+            }
+            else if (i == j) {
+                break;
+            }
+            ++i;
+        }
+
+        // One side is exhausted: insert the remaining elements with Fisher-Yates
+        for (; i < n; ++i) {
+            size_t m = size_t(randomIndex(g, i + 1));
+            swap(first[i], first[m]);
+        }
+    }
+
+    //---------------------------------
+    // Stable partition in two parallel passes: pred of every element and the trues of every chunk (pass 1),
+    // then place(i, to) for every element, where to is its index once partitioned (pass 2). split (the
+    // number of trues) is set before pass 2.
+    template <class T, class Predicate, class Place>
+    inline void
+    stablePartitionPasses(const T *items, size_t n, size_t numChunks, Predicate &pred, size_t &split, Place &&place) {
+        std::vector<uint8_t> flags(n);
+        std::vector<size_t>  trues(numChunks);
+        parallelFor(numChunks, numChunks, [&](size_t c) {
+            Predicate chunkPred = pred;
+            size_t    count     = 0;
+            for (size_t i = n * c / numChunks; i < n * (c + 1) / numChunks; ++i) {
+                flags[i] = chunkPred(items[i]) ? 1 : 0;
+                count   += flags[i];
+            }
+            trues[c] = count;
+        });
+
+        // trues[c]: trues before chunk c
+        split = 0;
+        for (size_t c = 0; c < numChunks; ++c) {
+            const size_t count = trues[c];
+            trues[c] = split;
+            split   += count;
+        }
+
+        parallelFor(numChunks, numChunks, [&](size_t c) {
+            const size_t first = n * c / numChunks;
+            size_t       t     = trues[c];
+            size_t       f     = split + first - trues[c];
+            for (size_t i = first; i < n * (c + 1) / numChunks; ++i)
+                place(i, flags[i] ? t++ : f++);
+        });
+    }
+
+    //---------------------------------
+    constexpr size_t kMinForEachGrain = 1024;
+
+    // Calls op(first, last, firstIndex) for the chunks of grain elements of [items, items + n), handed out to
+    // the threads one at a time by parallelFor, or once for the whole range with a sequential policy
+    template <class Pointer, class Op>
+    inline void
+    forEachChunk(ExecutionPolicy policy, const char *name, Pointer items, size_t n, size_t grain, Op &op) {
+        const size_t numThreads = hardwareThreads();
+        if (grain == 0)
+            grain = std::max<size_t>(kMinForEachGrain, n / (numThreads * 8));
+        const size_t numChunks = (n + grain - 1) / grain;
+
+        policy = resolvePolicy(policy, PolicyOperation::transform, n);
+        TVECTOR_TRACE_SCOPE(name, n, policy);
+        (void) name;
+        if (policy == ExecutionPolicy::seq || policy == ExecutionPolicy::unseq || numChunks <= 1) {
+            if (n != 0)
+                op(items, items + n, size_t(0));
+            return;
+        }
+
+        parallelFor(numChunks, numThreads, [&](size_t c) {
+            const size_t first = c * grain;
+            op(items + first, items + std::min(n, first + grain), first);
+        });
+    }
+
+    //---------------------------------
+    // Elements per unit of the cancellable operations: the token is checked at least this often
+    constexpr size_t kCancelGrain = 64 * 1024;
+
+    // Calls unit(u) for u in [0, numUnits) (in parallel unless policy is seq or unseq) until token is cancelled.
+    // Returns whether every unit ran.
+    template <class Unit>
+    inline bool
+    cancellableUnits(ExecutionPolicy policy, size_t numUnits, const TCancellationToken &token, Unit &&unit) {
+        const bool        parallel = (policy != ExecutionPolicy::seq && policy != ExecutionPolicy::unseq);
+        std::atomic<bool> stopped { false };
+        parallelFor(numUnits, parallel ? 0 : 1, [&](size_t u) {
+            if (stopped.load(std::memory_order_relaxed) || token.is_cancelled()) {
+                stopped.store(true, std::memory_order_relaxed);
+                return;
+            }
+            unit(u);
+        });
+        return stopped.load() == false;
+    }
+
+} // end of namespace detail
+
+//-------------------------------------
+// Unbiased parallel shuffle.
+// The range is split in numBlocks blocks that are shuffled in parallel (Fisher-Yates),
+// then adjacent blocks are merged by pairs, also in parallel, until one block remains.
+// Every block and merge has its own random stream derived from seed, so the result
+// only depends on (seed, numBlocks, size) and not on thread scheduling.
+//-------------------------------------
+template <class Iterator>
+inline void
+mergeShuffle(Iterator first, Iterator last, uint64_t seed, size_t numBlocks, size_t numThreads = 0) {
+    using std::swap;
+
+    size_t n = size_t(last - first);
+    numBlocks = std::max<size_t>(1, std::min(numBlocks, n));
+
+    std::vector<size_t> bounds(numBlocks + 1);
+    for (size_t b = 0; b <= numBlocks; ++b)
+        bounds[b] = n * b / numBlocks;
+
+    detail::parallelFor(numBlocks, numThreads, [&](size_t b) {
+        Xoshiro256 g = detail::randomStream(seed, 0, b);
+        for (size_t i = bounds[b]; i + 1 < bounds[b + 1]; ++i) {
+            size_t j = i + size_t(randomIndex(g, bounds[b + 1] - i));
+            swap(first[i], first[j]);
+        }
+    });
+
+    for (size_t width = 1, level = 1; width < numBlocks; width *= 2, ++level) {
+        size_t numPairs = (numBlocks + 2 * width - 1) / (2 * width);
+        detail::parallelFor(numPairs, numThreads, [&](size_t p) {
+            size_t left   = p * 2 * width;
+            size_t middle = std::min(left + width, numBlocks);
+            size_t right  = std::min(left + 2 * width, numBlocks);
+            if (middle < right) {
+                Xoshiro256 g = detail::randomStream(seed, level, p);
+                detail::mergeShuffled(first + bounds[left], first + bounds[middle], first + bounds[right], g);
+            }
+        });
+    }
+}
+
+// TVector members (declared in core_TVector.h)
+//-------------------------------------
+template <class T, class Allocator>
+TVector<T, Allocator> &
+TVector<T, Allocator>::shuffle(ExecutionPolicy policy, uint64_t seed, size_type numThreads) {
+    if (policy == ExecutionPolicy::seq || policy == ExecutionPolicy::unseq)
+        numThreads = 1;
+    else if (numThreads == 0)
+        numThreads = detail::hardwareThreads();
+
+    TVECTOR_TRACE_SCOPE("shuffle", size(), policy);
+    size_type numBlocks = std::max<size_type>(1, std::min(numThreads, size() / kMinShuffleBlock));
+    mergeShuffle(begin(), end(), seed, numBlocks, numThreads);
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+TVector<T, Allocator> &
+TVector<T, Allocator>::shuffle(ExecutionPolicy policy) {
+    return shuffle(policy, defaultRandomEngine()());
+}
+
+//-------------------------------------
+// Every thread selects the top k of its chunk, and the top k of those candidates is the result
+template <class T, class Allocator>
+template <class Less>
+TVector<T, Allocator>
+TVector<T, Allocator>::top_k(ExecutionPolicy policy, size_type k, Less less) const {
+    policy = resolvePolicy(policy, PolicyOperation::transform, size());
+    size_type numChunks = detail::hardwareThreads();
+    // Chunks must be much bigger than k, or merging the candidates costs as much as the selection
+    numChunks = std::min(numChunks, size() / std::max<size_type>(detail::kMinParallelGrain, 8 * k));
+    if (policy == ExecutionPolicy::seq || policy == ExecutionPolicy::unseq || numChunks <= 1)
+        return top_k(k, less);
+
+    TVECTOR_TRACE_SCOPE("top_k", size(), policy);
+    std::vector<tvector> candidates(numChunks);
+    detail::parallelFor(numChunks, numChunks, [&](size_t c) {
+        auto first = cbegin() + ptrdiff(size() * c / numChunks);
+        auto last  = cbegin() + ptrdiff(size() * (c + 1) / numChunks);
+        detail::topK(first, last, k, less, candidates[c]);
+    });
+
+    tvector merged;
+    for (auto &chunk : candidates)
+        merged.insert(merged.end(), std::make_move_iterator(chunk.begin()), std::make_move_iterator(chunk.end()));
+
+    tvector result;
+    detail::topK(merged.cbegin(), merged.cend(), k, less, result);
+    return result;
+}
+
+//-------------------------------------
+// The output is split in value ranges: splitters are quantiles of a sample of the runs, and every
+// run is cut at them with lower_bound. Each thread merges its cuts into its slice of the output.
+template <class T, class Allocator>
+template <class Runs, class Less>
+TVector<T, Allocator>
+TVector<T, Allocator>::merge_sorted(ExecutionPolicy policy, const Runs &runs, Less less) {
+    using Range = std::pair<const T *, const T *>;
+
+    std::vector<Range> ranges;
+    size_type          total = 0;
+    for (const auto &run : runs) {
+        ranges.emplace_back(run.data(), run.data() + run.size());
+        total += run.size();
+    }
+
+    policy = resolvePolicy(policy, PolicyOperation::transform, total);
+    size_type numParts = std::min(detail::hardwareThreads(), total / detail::kMinParallelGrain);
+    if (policy == ExecutionPolicy::seq || policy == ExecutionPolicy::unseq || numParts <= 1 || ranges.size() < 2)
+        return merge_sorted(runs, less);
+
+    TVECTOR_TRACE_SCOPE("merge_sorted", total, policy);
+    std::vector<T> sample;
+    size_type      step = std::max<size_type>(1, total / (numParts * 64));
+    for (const Range &range : ranges) {
+        for (size_type i = step / 2; i < size_type(range.second - range.first); i += step)
+            sample.push_back(range.first[i]);
+    }
+    std::sort(sample.begin(), sample.end(), less);
+
+    // cuts[p * numRuns + r]: first element of run r in part p
+    const size_type        numRuns = ranges.size();
+    std::vector<size_type> cuts((numParts + 1) * numRuns);
+    std::vector<size_type> offsets(numParts + 1, 0);
+    for (size_type p = 0; p <= numParts; ++p) {
+        for (size_type r = 0; r < numRuns; ++r) {
+            const Range &range = ranges[r];
+            size_type   cut    = (p == numParts) ? size_type(range.second - range.first) : 0;
+            if (p > 0 && p < numParts && sample.empty() == false)
+                cut = size_type(std::lower_bound(range.first, range.second, sample[sample.size() * p / numParts], less) - range.first);
+            cuts[p * numRuns + r] = cut;
+            offsets[p]           += cut;
+        }
+    }
+
+    tvector result(total);
+    detail::parallelFor(numParts, numParts, [&](size_t p) {
+        std::vector<Range> parts;
+        parts.reserve(numRuns);
+        for (size_type r = 0; r < numRuns; ++r)
+            parts.emplace_back(ranges[r].first + cuts[p * numRuns + r], ranges[r].first + cuts[(p + 1) * numRuns + r]);
+
+        Less partLess = less;
+        detail::mergeRuns(parts, partLess, result.begin() + ptrdiff(offsets[p]));
+    });
+    return result;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Queries, class Output, class Less>
+const TVector<T, Allocator> &
+TVector<T, Allocator>::lower_bound_many(ExecutionPolicy policy, const Queries &queries, Output firstOutput, Less less) const {
+    static_assert(std::is_reference<decltype(*std::declval<Output &>())>::value,
+                  "The chunks of lower_bound_many are written by different threads: the output cannot be a proxy (std::vector<bool>)");
+    const size_type count = queries.size();
+    policy = resolvePolicy(policy, PolicyOperation::transform, count, detail::log2Cost(size()));
+    size_type numChunks = std::min(detail::hardwareThreads(), count / detail::kMinSearchChunk);
+    if (policy == ExecutionPolicy::seq || policy == ExecutionPolicy::unseq || numChunks <= 1)
+        return lower_bound_many(queries, firstOutput, less);
+
+    TVECTOR_TRACE_SCOPE("lower_bound_many", count, policy);
+    detail::parallelFor(numChunks, numChunks, [&](size_t c) {
+        Less chunkLess = less;
+        detail::lowerBoundBatch(data(), size(), queries, count * c / numChunks, count * (c + 1) / numChunks, chunkLess,
+                                [&firstOutput](size_t i, size_t pos) { firstOutput[i] = pos; });
+    });
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Queries, class Output, class Less>
+const TVector<T, Allocator> &
+TVector<T, Allocator>::binary_search_many(ExecutionPolicy policy, const Queries &queries, Output firstOutput, Less less) const {
+    static_assert(std::is_reference<decltype(*std::declval<Output &>())>::value,
+                  "The chunks of binary_search_many are written by different threads: the output cannot be a proxy (std::vector<bool>)");
+    const size_type count = queries.size();
+    policy = resolvePolicy(policy, PolicyOperation::transform, count, detail::log2Cost(size()));
+    size_type numChunks = std::min(detail::hardwareThreads(), count / detail::kMinSearchChunk);
+    if (policy == ExecutionPolicy::seq || policy == ExecutionPolicy::unseq || numChunks <= 1)
+        return binary_search_many(queries, firstOutput, less);
+
+    TVECTOR_TRACE_SCOPE("binary_search_many", count, policy);
+    const T         *items = data();
+    const size_type n      = size();
+    detail::parallelFor(numChunks, numChunks, [&](size_t c) {
+        Less chunkLess = less;
+        detail::lowerBoundBatch(items, n, queries, count * c / numChunks, count * (c + 1) / numChunks, chunkLess,
+                                [&](size_t i, size_t pos) { firstOutput[i] = (pos < n) && !chunkLess(queries[i], items[pos]); });
+    });
+    return *this;
+}
+
+//-------------------------------------
+// Each thread groups a chunk in its own table. The tables are merged in chunk order, so the keys keep
+// the order of first appearance.
+template <class T, class Allocator>
+template <class KeyFn, class Hash>
+TVector<std::pair<typename TVector<T, Allocator>::template KeyOf<KeyFn>, size_t>>
+TVector<T, Allocator>::count_by(ExecutionPolicy policy, KeyFn keyFn, Hash hash) const {
+    auto one = [](size_type count, const T &) { return count + 1; };
+    auto sum = [](size_type a, size_type b) { return a + b; };
+    return aggregate_by(policy, keyFn, size_type(0), one, sum, hash);
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class KeyFn, class U, class Op, class Combine, class Hash>
+TVector<std::pair<typename TVector<T, Allocator>::template KeyOf<KeyFn>, U>>
+TVector<T, Allocator>::aggregate_by(ExecutionPolicy policy, KeyFn keyFn, U init, Op op, Combine combine, Hash hash) const {
+    using Key   = KeyOf<KeyFn>;
+    using Table = detail::GroupTable<Key, Hash>;
+
+    policy = resolvePolicy(policy, PolicyOperation::transform, size(), 4.0);   // A hash and a probe per element
+    size_type numChunks = std::min(detail::hardwareThreads(), size() / detail::kMinParallelGrain);
+    if (policy == ExecutionPolicy::seq || policy == ExecutionPolicy::unseq || numChunks <= 1)
+        return aggregate_by(keyFn, init, op, hash);
+
+    TVECTOR_TRACE_SCOPE("aggregate_by", size(), policy);
+    std::vector<Table>      tables(numChunks, Table(hash));
+    std::vector<TVector<U>> values(numChunks);
+    detail::parallelFor(numChunks, numChunks, [&](size_t c) {
+        KeyFn chunkKeyFn = keyFn;
+        Op    chunkOp    = op;
+        detail::aggregateRange(data() + size() * c / numChunks, data() + size() * (c + 1) / numChunks,
+                               chunkKeyFn, init, chunkOp, tables[c], values[c]);
+    });
+
+    // The first table is the result; the others are added to it
+    Table      &table  = tables[0];
+    TVector<U> &result = values[0];
+    for (size_t c = 1; c < numChunks; ++c) {
+        TVector<Key> &keys = tables[c].keys();
+        for (size_t g = 0; g < keys.size(); ++g) {
+            const size_t id = table.id(std::move(keys[g]));
+            if (id == result.size())
+                result.push_back(std::move(values[c][g]));
+            else
+                result[id] = combine(std::move(result[id]), std::move(values[c][g]));
+        }
+    }
+    return detail::zipGroups(table.keys(), result);
+}
+
+//-------------------------------------
+// Scans read the data twice (pass 1 and pass 2 of detail::parallelScan)
+template <class T, class Allocator>
+template <class BinaryOperation, class>
+TVector<T, Allocator> &
+TVector<T, Allocator>::inclusive_scan(ExecutionPolicy policy, BinaryOperation op) & {
+    inclusive_scan(policy, data(), op);
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Output, class BinaryOperation, class>
+const TVector<T, Allocator> &
+TVector<T, Allocator>::inclusive_scan(ExecutionPolicy policy, Output firstOutput, BinaryOperation op) const {
+    policy = resolvePolicy(policy, PolicyOperation::transform, size());
+    if (policy == ExecutionPolicy::seq)
+        return inclusive_scan(firstOutput, op);
+
+    TVECTOR_TRACE_SCOPE("inclusive_scan", size(), policy);
+    const T   *items    = data();
+    size_type numChunks = std::min(detail::hardwareThreads(), size() / detail::kMinParallelGrain);
+    if (policy == ExecutionPolicy::unseq || numChunks <= 1) {
+        detail::inclusiveScanBlocks(items, size(), firstOutput, op, static_cast<const T *>(nullptr), detail::IsFloatSum<T, BinaryOperation> {});
+        return *this;
+    }
+
+    detail::Identity identity;
+    detail::parallelScan(items, size(), numChunks, op, identity, static_cast<const T *>(nullptr),
+                         [&](size_t first, size_t last, const T *carry) {
+        BinaryOperation chunkOp = op;
+        detail::inclusiveScanBlocks(items + first, last - first, firstOutput + first, chunkOp, carry, detail::IsFloatSum<T, BinaryOperation> {});
+    });
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class U, class BinaryOperation, class>
+TVector<T, Allocator> &
+TVector<T, Allocator>::exclusive_scan(ExecutionPolicy policy, U init, BinaryOperation op) & {
+    exclusive_scan(policy, data(), T(init), op);
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Output, class U, class BinaryOperation, class>
+const TVector<T, Allocator> &
+TVector<T, Allocator>::exclusive_scan(ExecutionPolicy policy, Output firstOutput, U init, BinaryOperation op) const {
+    policy = resolvePolicy(policy, PolicyOperation::transform, size());
+    size_type numChunks = std::min(detail::hardwareThreads(), size() / detail::kMinParallelGrain);
+    if (policy == ExecutionPolicy::seq || policy == ExecutionPolicy::unseq || numChunks <= 1)
+        return exclusive_scan(firstOutput, init, op);
+
+    TVECTOR_TRACE_SCOPE("exclusive_scan", size(), policy);
+    detail::Identity identity;
+    const T          *items = data();
+    detail::parallelScan(items, size(), numChunks, op, identity, &init, [&](size_t first, size_t last, const U *carry) {
+        BinaryOperation chunkOp = op;
+        detail::exclusiveScan(items + first, last - first, firstOutput + first, chunkOp, identity, *carry);
+    });
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class BinaryOperation, class UnaryOperation>
+TVector<T, Allocator> &
+TVector<T, Allocator>::transform_inclusive_scan(ExecutionPolicy policy, BinaryOperation op, UnaryOperation transform) & {
+    transform_inclusive_scan(policy, data(), op, transform);
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Output, class BinaryOperation, class UnaryOperation>
+const TVector<T, Allocator> &
+TVector<T, Allocator>::transform_inclusive_scan(ExecutionPolicy policy, Output firstOutput, BinaryOperation op, UnaryOperation transform) const {
+    using U = typename std::decay<decltype(transform(std::declval<const T &>()))>::type;
+
+    policy = resolvePolicy(policy, PolicyOperation::transform, size());
+    size_type numChunks = std::min(detail::hardwareThreads(), size() / detail::kMinParallelGrain);
+    if (policy == ExecutionPolicy::seq || policy == ExecutionPolicy::unseq || numChunks <= 1)
+        return transform_inclusive_scan(firstOutput, op, transform);
+
+    TVECTOR_TRACE_SCOPE("transform_inclusive_scan", size(), policy);
+    const T *items = data();
+    detail::parallelScan(items, size(), numChunks, op, transform, static_cast<const U *>(nullptr),
+                         [&](size_t first, size_t last, const U *carry) {
+        BinaryOperation chunkOp        = op;
+        UnaryOperation  chunkTransform = transform;
+        detail::inclusiveScan(items + first, last - first, firstOutput + first, chunkOp, chunkTransform, carry);
+    });
+    return *this;
+}
+
+//-------------------------------------
+// Every chunk is partitioned in its thread. The falses left before the split and the trues after it are the
+// same number: they are swapped, with the swaps split between the threads.
+template <class T, class Allocator>
+template <class Predicate>
+typename TVector<T, Allocator>::size_type
+TVector<T, Allocator>::partition(ExecutionPolicy policy, Predicate pred) {
+    policy = resolvePolicy(policy, PolicyOperation::transform, size());
+    size_type numChunks = std::min(detail::hardwareThreads(), size() / detail::kMinParallelGrain);
+    if (policy == ExecutionPolicy::seq || policy == ExecutionPolicy::unseq || numChunks <= 1)
+        return partition(pred);
+
+    TVECTOR_TRACE_SCOPE("partition", size(), policy);
+    T                   *items = data();
+    const size_t        n      = size();
+    std::vector<size_t> splits(numChunks);
+    detail::parallelFor(numChunks, numChunks, [&](size_t c) {
+        Predicate chunkPred = pred;
+        splits[c] = size_t(std::partition(items + n * c / numChunks, items + n * (c + 1) / numChunks, chunkPred) - items);
+    });
+
+    size_t split = 0;
+    for (size_t c = 0; c < numChunks; ++c)
+        split += splits[c] - n * c / numChunks;
+
+    // Misplaced ranges: falses before split and trues after it
+    using Range = std::pair<size_t, size_t>;
+    std::vector<Range> falses, trues;
+    size_t             numSwaps = 0;
+    for (size_t c = 0; c < numChunks; ++c) {
+        if (splits[c] < split && n * (c + 1) / numChunks > splits[c]) {
+            falses.emplace_back(splits[c], std::min(n * (c + 1) / numChunks, split));
+            numSwaps += falses.back().second - falses.back().first;
+        }
+        if (splits[c] > split && n * c / numChunks < splits[c])
+            trues.emplace_back(std::max(n * c / numChunks, split), splits[c]);
+    }
+
+    // k-th position of a list of ranges, as (range, position)
+    auto locate = [](const std::vector<Range> &ranges, size_t k) {
+        size_t r = 0;
+        while (k >= ranges[r].second - ranges[r].first) {
+            k -= ranges[r].second - ranges[r].first;
+            ++r;
+        }
+        return Range(r, ranges[r].first + k);
+    };
+
+    const size_t numParts = std::min<size_t>(numChunks, numSwaps);
+    detail::parallelFor(numParts, numParts, [&](size_t p) {
+        const size_t first = numSwaps * p / numParts;
+        const size_t last  = numSwaps * (p + 1) / numParts;
+        if (first == last)
+            return;
+
+        Range f = locate(falses, first);
+        Range t = locate(trues, first);
+        for (size_t k = first; k < last; ++k) {
+            std::iter_swap(items + f.second, items + t.second);
+            if (++f.second == falses[f.first].second && k + 1 < last)
+                f = Range(f.first + 1, falses[f.first + 1].first);
+            if (++t.second == trues[t.first].second && k + 1 < last)
+                t = Range(t.first + 1, trues[t.first + 1].first);
+        }
+    });
+    return split;
+}
+
+//-------------------------------------
+// Scan based: the destination of every element is the number of trues (or falses) before it
+template <class T, class Allocator>
+template <class Predicate>
+typename TVector<T, Allocator>::size_type
+TVector<T, Allocator>::stable_partition(ExecutionPolicy policy, Predicate pred) {
+    const bool nothrowMove = std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value;
+
+    policy = resolvePolicy(policy, PolicyOperation::transform, size());
+    size_type numChunks = std::min(detail::hardwareThreads(), size() / detail::kMinParallelGrain);
+    if (policy == ExecutionPolicy::seq || policy == ExecutionPolicy::unseq || numChunks <= 1 || nothrowMove == false)
+        return stable_partition(pred);
+
+    // The scratch buffer comes from the allocator of the vector
+    using ScratchAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+    using ScratchTraits    = std::allocator_traits<ScratchAllocator>;
+
+    TVECTOR_TRACE_SCOPE("stable_partition", size(), policy);
+    T                  *items = data();
+    const size_t       n      = size();
+    ScratchAllocator   allocator(this->get_allocator());
+    T                  *buffer = ScratchTraits::allocate(allocator, n);
+    size_t             split   = 0;
+    try {
+        detail::stablePartitionPasses(items, n, numChunks, pred, split, [&](size_t i, size_t to) {
+            ScratchTraits::construct(allocator, buffer + to, std::move(items[i]));
+        });
+    }
+    catch (...) {
+        ScratchTraits::deallocate(allocator, buffer, n);    // pred threw in the first pass: nothing was moved
+        throw;
+    }
+
+    detail::parallelFor(numChunks, numChunks, [&](size_t c) {
+        for (size_t i = n * c / numChunks; i < n * (c + 1) / numChunks; ++i) {
+            items[i] = std::move(buffer[i]);
+            ScratchTraits::destroy(allocator, buffer + i);
+        }
+    });
+    ScratchTraits::deallocate(allocator, buffer, n);
+    return split;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class OutputTrue, class OutputFalse, class Predicate>
+typename TVector<T, Allocator>::size_type
+TVector<T, Allocator>::partition_copy(ExecutionPolicy policy, OutputTrue firstTrue, OutputFalse firstFalse, Predicate pred) const {
+    policy = resolvePolicy(policy, PolicyOperation::transform, size());
+    size_type numChunks = std::min(detail::hardwareThreads(), size() / detail::kMinParallelGrain);
+    if (policy == ExecutionPolicy::seq || policy == ExecutionPolicy::unseq || numChunks <= 1)
+        return partition_copy(firstTrue, firstFalse, pred);
+
+    TVECTOR_TRACE_SCOPE("partition_copy", size(), policy);
+    const T *items = data();
+    size_t  split  = 0;
+    detail::stablePartitionPasses(items, size(), numChunks, pred, split, [&](size_t i, size_t to) {
+        if (to < split)
+            firstTrue[to] = items[i];
+        else
+            firstFalse[to - split] = items[i];
+    });
+    return split;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Op>
+TVector<T, Allocator> &
+TVector<T, Allocator>::for_each_chunk(ExecutionPolicy policy, Op op, size_type grain) {
+    detail::forEachChunk(policy, "for_each_chunk", data(), size(), grain, op);
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Op>
+const TVector<T, Allocator> &
+TVector<T, Allocator>::for_each_chunk(ExecutionPolicy policy, Op op, size_type grain) const {
+    detail::forEachChunk(policy, "for_each_chunk", data(), size(), grain, op);
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Op>
+TVector<T, Allocator> &
+TVector<T, Allocator>::for_each(ExecutionPolicy policy, Op op, size_type grain) {
+    auto chunk = [&op](T *first, T *last, size_t) {
+        for (; first != last; ++first)
+            op(*first);
+    };
+    detail::forEachChunk(policy, "for_each", data(), size(), grain, chunk);
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Op>
+const TVector<T, Allocator> &
+TVector<T, Allocator>::for_each(ExecutionPolicy policy, Op op, size_type grain) const {
+    auto chunk = [&op](const T *first, const T *last, size_t) {
+        for (; first != last; ++first)
+            op(*first);
+    };
+    detail::forEachChunk(policy, "for_each", data(), size(), grain, chunk);
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Op>
+TVector<T, Allocator> &
+TVector<T, Allocator>::for_each_indexed(ExecutionPolicy policy, Op op, size_type grain) {
+    auto chunk = [&op](T *first, T *last, size_t index) {
+        for (; first != last; ++first, ++index)
+            op(index, *first);
+    };
+    detail::forEachChunk(policy, "for_each_indexed", data(), size(), grain, chunk);
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Op>
+const TVector<T, Allocator> &
+TVector<T, Allocator>::for_each_indexed(ExecutionPolicy policy, Op op, size_type grain) const {
+    auto chunk = [&op](const T *first, const T *last, size_t index) {
+        for (; first != last; ++first, ++index)
+            op(index, *first);
+    };
+    detail::forEachChunk(policy, "for_each_indexed", data(), size(), grain, chunk);
+    return *this;
+}
+
+//-------------------------------------
+// Cancellable: units of kCancelGrain elements
+template <class T, class Allocator>
+template <class Output, class UnaryOperation>
+bool
+TVector<T, Allocator>::transform(ExecutionPolicy policy, Output firstOutput, UnaryOperation op, const TCancellationToken &token) const {
+    using detail::kCancelGrain;
+
+    policy = resolvePolicy(policy, PolicyOperation::transform, size());
+    TVECTOR_TRACE_SCOPE("transform", size(), policy);
+    const T      *items = data();
+    const size_t n      = size();
+    return detail::cancellableUnits(policy, (n + kCancelGrain - 1) / kCancelGrain, token, [&](size_t u) {
+        std::transform(items + u * kCancelGrain, items + std::min(n, (u + 1) * kCancelGrain), firstOutput + u * kCancelGrain, op);
+    });
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Output, class UnaryOperation>
+bool
+TVector<T, Allocator>::transform(ExecutionPolicy policy, Output firstOutput, UnaryOperation op, const TCancellationToken &token) {
+    return static_cast<const tvector &>(*this).transform(policy, firstOutput, op, token);
+}
+
+//-------------------------------------
+// Every unit is reduced on its own, and the results are added to init in order
+template <class T, class Allocator>
+template <class U, class BinaryOperation>
+TCancellable<U>
+TVector<T, Allocator>::reduce(ExecutionPolicy policy, U init, BinaryOperation op, const TCancellationToken &token) const {
+    return transform_reduce(policy, init, op, detail::Identity {}, token);
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class U, class BinaryReductionOp, class UnaryTransformOp>
+TCancellable<U>
+TVector<T, Allocator>::transform_reduce(ExecutionPolicy policy, U init, BinaryReductionOp reduce, UnaryTransformOp transform, const TCancellationToken &token) const {
+    using detail::kCancelGrain;
+
+    policy = resolvePolicy(policy, PolicyOperation::transform_reduce, size());
+    TVECTOR_TRACE_SCOPE("transform_reduce", size(), policy);
+    const T         *items   = data();
+    const size_t    n        = size();
+    const size_t    numUnits = (n + kCancelGrain - 1) / kCancelGrain;
+    std::vector<U>  partials(numUnits, init);
+    TCancellable<U> result;
+    result.completed = detail::cancellableUnits(policy, numUnits, token, [&](size_t u) {
+        const T *first = items + u * kCancelGrain;
+        const T *last  = items + std::min(n, (u + 1) * kCancelGrain);
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+        partials[u] = std::transform_reduce(first + 1, last, U(transform(*first)), reduce, transform);  // Unrolled
+#else
+        U acc = transform(*first);
+        for (++first; first != last; ++first)
+            acc = reduce(std::move(acc), transform(*first));
+        partials[u] = std::move(acc);
+#endif
+    });
+
+    if (result.completed) {
+        result.value = std::move(init);
+        for (U &partial : partials)
+            result.value = reduce(std::move(result.value), std::move(partial));
+    }
+    return result;
+}
+
+//-------------------------------------
+// Every unit is sorted, and then pairs of sorted runs are merged, a level at a time
+template <class T, class Allocator>
+template <class Less>
+bool
+TVector<T, Allocator>::sort(ExecutionPolicy policy, Less less, const TCancellationToken &token) {
+    using detail::kCancelGrain;
+
+    policy = resolvePolicy(policy, PolicyOperation::transform, size(), 8.0);   // Several comparisons per element
+    TVECTOR_TRACE_SCOPE("sort", size(), policy);
+    T            *items = data();
+    const size_t n      = size();
+    bool         completed = detail::cancellableUnits(policy, (n + kCancelGrain - 1) / kCancelGrain, token, [&](size_t u) {
+        std::sort(items + u * kCancelGrain, items + std::min(n, (u + 1) * kCancelGrain), less);
+    });
+
+    for (size_t width = kCancelGrain; completed && width < n; width *= 2) {
+        completed = detail::cancellableUnits(policy, (n + 2 * width - 1) / (2 * width), token, [&](size_t p) {
+            const size_t first  = p * 2 * width;
+            const size_t middle = std::min(n, first + width);
+            std::inplace_merge(items + first, items + middle, items + std::min(n, first + 2 * width), less);
+        });
+    }
+    return completed;
+}
+
+//-------------------------------------
+// Every unit is filtered to its own vector, and they are joined in order
+template <class T, class Allocator>
+template <class Predicate>
+TCancellable<TVector<T, Allocator>>
+TVector<T, Allocator>::filter(ExecutionPolicy policy, Predicate pred, const TCancellationToken &token) const {
+    using detail::kCancelGrain;
+
+    policy = resolvePolicy(policy, PolicyOperation::transform, size());
+    TVECTOR_TRACE_SCOPE("filter", size(), policy);
+    const T               *items = data();
+    const size_t          n      = size();
+    std::vector<tvector>  parts((n + kCancelGrain - 1) / kCancelGrain);
+    TCancellable<tvector> result;
+    result.completed = detail::cancellableUnits(policy, parts.size(), token, [&](size_t u) {
+        std::copy_if(items + u * kCancelGrain, items + std::min(n, (u + 1) * kCancelGrain), std::back_inserter(parts[u]), pred);
+    });
+
+    if (result.completed) {
+        size_t total = 0;
+        for (const tvector &part : parts)
+            total += part.size();
+        result.value.reserve(total);
+        for (tvector &part : parts)
+            std::move(part.begin(), part.end(), std::back_inserter(result.value));
+    }
+    return result;
+}
+
+} // end of namespace
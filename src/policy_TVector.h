@@ -0,0 +1,148 @@
+#pragma once
+
+//-------------------------------------
+// Execution policies of the TVector algorithms, the thresholds of ExecutionPolicy::automatic and the
+// compile-time policy tags. Included by core_TVector.h, so it does not include thread headers: what needs
+// them (resolvePolicy, ExecutionThresholds::global() and TCancellationToken) is in threads_TVector.h.
+//-------------------------------------
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace MindShake {
+
+//#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+
+    enum class ExecutionPolicy {
+        seq,        // std::execution::seq: execution may not be parallelized.
+        par,        // std::execution::par: execution may be parallelized.
+        par_unseq,  // std::execution::par_unseq: execution may be parallelized, vectorized, or migrated across threads.
+        unseq,      // std::execution::unseq: execution may be vectorized. [C++20]
+        automatic,  // seq or par depending on the number of elements (see ExecutionThresholds).
+    };
+
+//#endif
+
+//-------------------------------------
+// Operations that can use ExecutionPolicy::automatic
+enum class PolicyOperation {
+    transform,
+    reduce,
+    transform_reduce,
+};
+
+//-------------------------------------
+// Number of elements (of a cheap operation, like an integer addition) from which par is faster than seq.
+// The defaults are conservative. Run the calibration tool (benchmarks/calibrate.cpp) in the host to
+// measure them and load the generated file with load() or with the TVECTOR_THRESHOLDS environment variable.
+// Configure them at startup: they are not synchronized.
+//-------------------------------------
+struct ExecutionThresholds {
+    size_t  transform           = 64 * 1024;
+    size_t  reduce              = 128 * 1024;
+    size_t  transform_reduce    = 64 * 1024;
+
+    size_t get(PolicyOperation op) const {
+        switch (op) {
+            case PolicyOperation::transform:        return transform;
+            case PolicyOperation::reduce:           return reduce;
+            case PolicyOperation::transform_reduce: return transform_reduce;
+        }
+        return transform;
+    }
+
+    // Global thresholds. The first time they are loaded from the file in TVECTOR_THRESHOLDS (if any).
+    // Defined in threads_TVector.h
+    static ExecutionThresholds & global();
+
+    // Format: one "name = value" per line. Lines starting with # are comments. Unknown names are ignored.
+    bool load(const char *path) {
+        FILE *file = fopen(path, "rt");
+        if (file == nullptr)
+            return false;
+
+        char line[256];
+        while (fgets(line, sizeof(line), file) != nullptr) {
+            char               name[64];
+            unsigned long long value;
+            if (line[0] == '#' || sscanf(line, " %63[a-z_] = %llu", name, &value) != 2)
+                continue;
+
+            if (strcmp(name, "transform") == 0)
+                transform = size_t(value);
+            else if (strcmp(name, "reduce") == 0)
+                reduce = size_t(value);
+            else if (strcmp(name, "transform_reduce") == 0)
+                transform_reduce = size_t(value);
+        }
+        fclose(file);
+        return true;
+    }
+
+    bool save(const char *path) const {
+        FILE *file = fopen(path, "wt");
+        if (file == nullptr)
+            return false;
+
+        fprintf(file, "# TVector execution thresholds: number of elements from which par is used\n");
+        fprintf(file, "transform = %llu\n", (unsigned long long) transform);
+        fprintf(file, "reduce = %llu\n", (unsigned long long) reduce);
+        fprintf(file, "transform_reduce = %llu\n", (unsigned long long) transform_reduce);
+        return fclose(file) == 0;
+    }
+};
+
+//-------------------------------------
+// Defined in threads_TVector.h
+class TCancellationToken;
+
+//-------------------------------------
+// Result of an operation that can be cancelled: value is only meaningful when completed
+//-------------------------------------
+template <class R>
+struct TCancellable {
+    R       value     {};
+    bool    completed = false;
+
+    explicit operator bool() const                                          { return completed;                                             }
+};
+
+//-------------------------------------
+// Compile-time execution policies.
+// TVector members taking a tag select the std::execution policy at compile time, so only that variant
+// is instantiated. The ExecutionPolicy overloads are adapters that switch to the tags at runtime.
+//   v.transform(execution::par, out.begin(), op);
+// C++17 (inline variables), as the overloads taking them.
+//-------------------------------------
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+namespace execution {
+
+    template <ExecutionPolicy Policy>
+    struct policy_tag {
+        static constexpr ExecutionPolicy value = Policy;
+    };
+
+    using seq_t         = policy_tag<ExecutionPolicy::seq>;
+    using par_t         = policy_tag<ExecutionPolicy::par>;
+    using par_unseq_t   = policy_tag<ExecutionPolicy::par_unseq>;
+    using unseq_t       = policy_tag<ExecutionPolicy::unseq>;
+    using automatic_t   = policy_tag<ExecutionPolicy::automatic>;
+
+    inline constexpr seq_t          seq       {};
+    inline constexpr par_t          par       {};
+    inline constexpr par_unseq_t    par_unseq {};
+    inline constexpr unseq_t        unseq     {};
+    inline constexpr automatic_t    automatic {};
+
+    template <class T>
+    struct is_policy_tag : std::false_type {};
+    template <ExecutionPolicy Policy>
+    struct is_policy_tag<policy_tag<Policy>> : std::true_type {};
+
+} // end of namespace execution
+#endif
+
+} // end of namespace
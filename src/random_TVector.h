@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <unordered_map>
+#include "core_TVector.h"
+
+namespace MindShake {
+
+//-------------------------------------
+// SplitMix64: used to expand a single seed into the state of other generators
+inline uint64_t
+splitmix64(uint64_t &state) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+//-------------------------------------
+// xoshiro256** by David Blackman and Sebastiano Vigna.
+// Small (32 bytes), fast and good enough for shuffling and sampling.
+// Satisfies UniformRandomBitGenerator, so it can be used with <random> distributions.
+//-------------------------------------
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+public:
+    explicit Xoshiro256(uint64_t seed = 0x853c49e6748fea9bull)              { this->seed(seed);                                             }
+
+    void seed(uint64_t seed) {
+        for (auto &s : mState)
+            s = splitmix64(seed);
+    }
+
+    static constexpr result_type min()                                      { return 0;                                                     }
+    static constexpr result_type max()                                      { return std::numeric_limits<result_type>::max();               }
+
+    result_type operator()() {
+        const uint64_t result = rotl(mState[1] * 5, 7) * 9;
+        const uint64_t t      = mState[1] << 17;
+
+        mState[2] ^= mState[0];
+        mState[3] ^= mState[1];
+        mState[1] ^= mState[2];
+        mState[0] ^= mState[3];
+        mState[2] ^= t;
+        mState[3]  = rotl(mState[3], 45);
+
+        return result;
+    }
+
+protected:
+    static uint64_t rotl(uint64_t x, int k)                                 { return (x << k) | (x >> (64 - k));                            }
+
+protected:
+    uint64_t    mState[4];
+};
+
+//-------------------------------------
+// Per thread engine, created (and seeded from std::random_device) the first time each thread uses it.
+// It is never shared, so concurrent shuffles do not race.
+inline Xoshiro256 &
+defaultRandomEngine() {
+    static std::atomic<uint64_t> counter { 0 };
+    static thread_local Xoshiro256 engine = []() {
+        std::random_device rd;
+        uint64_t seed = (uint64_t(rd()) << 32) ^ rd();
+        // Just in case random_device is deterministic in this platform
+        seed ^= counter.fetch_add(1, std::memory_order_relaxed) * 0x9e3779b97f4a7c15ull;
+        return Xoshiro256(seed);
+    }();
+
+    return engine;
+}
+
+//-------------------------------------
+// Returns a uniformly distributed index in [0, n). n must be > 0.
+// 64 bit engines use Lemire's multiply-and-reject method, which avoids almost all divisions
+// and gives the same result in every platform. Other engines use std::uniform_int_distribution.
+//-------------------------------------
+namespace detail {
+
+    inline uint64_t
+    mulhi64(uint64_t a, uint64_t b, uint64_t &lo) {
+#if defined(__SIZEOF_INT128__)
+        __uint128_t m = __uint128_t(a) * b;
+        lo = uint64_t(m);
+        return uint64_t(m >> 64);
+#else
+        uint64_t aLo = a & 0xffffffff, aHi = a >> 32;
+        uint64_t bLo = b & 0xffffffff, bHi = b >> 32;
+        uint64_t p0  = aLo * bLo;
+        uint64_t p1  = aLo * bHi;
+        uint64_t p2  = aHi * bLo;
+        uint64_t p3  = aHi * bHi;
+        uint64_t mid = (p0 >> 32) + (p1 & 0xffffffff) + (p2 & 0xffffffff);
+        lo = (mid << 32) | (p0 & 0xffffffff);
+        return p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+#endif
+    }
+
+    template <class Engine>
+    inline uint64_t
+    randomIndex(Engine &g, uint64_t n, std::true_type) {
+        uint64_t lo;
+        uint64_t hi = mulhi64(g(), n, lo);
+        if (lo < n) {
+            const uint64_t threshold = (0 - n) % n;
+            while (lo < threshold)
+                hi = mulhi64(g(), n, lo);
+        }
+        return hi;
+    }
+
+    template <class Engine>
+    inline uint64_t
+    randomIndex(Engine &g, uint64_t n, std::false_type) {
+        return std::uniform_int_distribution<uint64_t>(0, n - 1)(g);
+    }
+
+    template <class Engine>
+    using IsFull64Engine = std::integral_constant<bool,
+        std::is_same<typename std::decay<Engine>::type::result_type, uint64_t>::value &&
+        std::decay<Engine>::type::min() == 0 &&
+        std::decay<Engine>::type::max() == std::numeric_limits<uint64_t>::max()>;
+
+} // end of namespace detail
+
+template <class Engine>
+inline uint64_t
+randomIndex(Engine &g, uint64_t n) {
+    return detail::randomIndex(g, n, detail::IsFull64Engine<Engine> {});
+}
+
+// TVector members (declared in core_TVector.h)
+//-------------------------------------
+template <class T, class Allocator>
+TVector<T, Allocator> &
+TVector<T, Allocator>::shuffle() {
+    return shuffle(defaultRandomEngine());
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Engine>
+TVector<T, Allocator> &
+TVector<T, Allocator>::shuffle(Engine &&g) {
+    return partial_shuffle(size(), g);
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+TVector<T, Allocator> &
+TVector<T, Allocator>::partial_shuffle(size_type k) {
+    return partial_shuffle(k, defaultRandomEngine());
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Engine>
+TVector<T, Allocator> &
+TVector<T, Allocator>::partial_shuffle(size_type k, Engine &&g) {
+    size_type n = size();
+    k = std::min(k, n > 0 ? n - 1 : 0);
+    for (size_type i = 0; i < k; ++i) {
+        size_type j = i + size_type(randomIndex(g, n - i));
+        std::swap(data()[i], data()[j]);
+    }
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+TVector<T, Allocator>
+TVector<T, Allocator>::sample(size_type k) const {
+    return sample(k, defaultRandomEngine());
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Engine>
+TVector<T, Allocator>
+TVector<T, Allocator>::sample(size_type k, Engine &&g) const {
+    size_type n = size();
+    k = std::min(k, n);
+
+    tvector output;
+    if (k * 8 >= n) {
+        // Dense: copying everything is cheaper than tracking the swaps
+        output = *this;
+        output.partial_shuffle(k, g);
+        output.erase(output.begin() + k, output.end());
+        return output;
+    }
+
+    // Sparse Fisher-Yates: only the swapped positions are stored
+    std::unordered_map<size_type, size_type> swapped;
+    swapped.reserve(k);
+    output.reserve(k);
+    for (size_type i = 0; i < k; ++i) {
+        size_type j = i + size_type(randomIndex(g, n - i));
+
+        auto      itI = swapped.find(i);
+        auto      itJ = swapped.find(j);
+        size_type vI  = (itI != swapped.end()) ? itI->second : i;
+        size_type vJ  = (itJ != swapped.end()) ? itJ->second : j;
+
+        output.push_back(data()[vJ]);
+        swapped[j] = vI;
+    }
+    return output;
+}
+
+} // end of namespace
@@ -0,0 +1,269 @@
+#pragma once
+
+//-------------------------------------
+// Search index for read-mostly sorted TVectors (see TVector::build_search_index).
+// An implicit B+ tree (S-tree) over the sorted vector: the vector itself is the leaf level and each upper
+// level keeps the last (biggest) element of every block of kBlock elements of the level below.
+// A lookup reads one block per level (one cache line for 4 byte elements) instead of one cache line per
+// halving, and the counting inside a block has no branches. The levels above the data take ~n / 15 elements.
+// Also the batched searches (lower_bound_many, binary_search_many): branchless binary searches of a batch of
+// queries advance together and prefetch their next probe, so the cache misses of the batch overlap.
+//-------------------------------------
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "core_TVector.h"
+
+namespace MindShake {
+
+namespace detail {
+
+    // Queries searched together: enough misses in flight to hide the memory latency
+    constexpr size_t kSearchBatch = 16;
+    // Queries per thread with an execution policy
+    constexpr size_t kMinSearchChunk = 1024;
+
+    //---------------------------------
+    // Calls emit(i, lower_bound position of queries[i]) for every i in [first, last).
+    // Every search of a batch does the same steps (the range only depends on n), without branches.
+    template <class T, class Queries, class Less, class Emit>
+    inline void
+    lowerBoundBatch(const T *data, size_t n, const Queries &queries, size_t first, size_t last, Less &less, Emit &&emit) {
+        if (n == 0) {
+            for (size_t i = first; i < last; ++i)
+                emit(i, size_t(0));
+            return;
+        }
+
+        const T *base[kSearchBatch];
+        for (size_t start = first; start < last; start += kSearchBatch) {
+            const size_t count = std::min(kSearchBatch, last - start);
+            for (size_t j = 0; j < count; ++j)
+                base[j] = data;
+
+            // The answer is in [base, base + len]
+            for (size_t len = n; len > 1;) {
+                const size_t half = len / 2;
+                for (size_t j = 0; j < count; ++j)
+                    base[j] = less(base[j][half], queries[start + j]) ? base[j] + half : base[j];
+                len -= half;
+                for (size_t j = 0; j < count; ++j)
+                    prefetch(base[j] + len / 2);
+            }
+
+            for (size_t j = 0; j < count; ++j)
+                emit(start + j, size_t(base[j] - data) + size_t(less(*base[j], queries[start + j])));
+        }
+    }
+
+} // end of namespace detail
+
+//-------------------------------------
+// The index does not copy the vector: it must not be modified (or reallocated) while the index is used.
+//-------------------------------------
+template <class T, class Less>
+class TSearchIndex {
+public:
+    using size_type = size_t;
+
+    static constexpr size_type npos   = size_type(-1);
+    // Elements per block: a cache line of small elements, between 4 and 16
+    static constexpr size_type kBlock = (sizeof(T) >= 16) ? 4 : (sizeof(T) >= 8) ? 8 : 16;
+
+public:
+    TSearchIndex() = default;
+
+    TSearchIndex(const T *data, size_type size, Less less = Less {})
+        : mData(data), mSize(size), mLess(less) {
+        // Data blocks start at block boundaries (a cache line, or part of one for 1 and 2 byte elements):
+        // the first one is shorter. The shift stays below kBlock.
+        const size_t address = size_t(reinterpret_cast<uintptr_t>(data));
+        if ((kLine % sizeof(T)) == 0 && (address % sizeof(T)) == 0)
+            mShift = ((address % kLine) / sizeof(T)) % kBlock;
+
+        // Sizes of the levels, from the one above the data to the top
+        std::vector<size_type> sizes;
+        for (size_type below = mShift + size; below > kBlock; below = sizes.back())
+            sizes.push_back((below + kBlock - 1) / kBlock);
+
+        // All levels in one buffer, each one starting at a cache line (when the allocation is aligned to T)
+        size_type total = 0;
+        for (size_type levelSize : sizes)
+            total += (levelSize + kBlock - 1) / kBlock * kBlock;
+        mStorage.resize(total + kLine / sizeof(T) + 1);
+
+        size_type offset = 0;
+        const size_t base = size_t(reinterpret_cast<uintptr_t>(mStorage.data()));
+        if ((kLine % sizeof(T)) == 0 && (base % sizeof(T)) == 0)
+            offset = ((kLine - base % kLine) % kLine) / sizeof(T);
+
+        const T   *below      = data;
+        size_type belowSize   = size;
+        size_type belowShift  = mShift;
+        for (size_type levelSize : sizes) {
+            T *level = mStorage.data() + offset;
+            for (size_type j = 0; j < levelSize; ++j) {
+                const size_type last = std::min((j + 1) * kBlock, belowShift + belowSize) - belowShift - 1;
+                level[j] = below[last];
+            }
+            mLevels.push_back(Level { offset, levelSize });
+            offset    += (levelSize + kBlock - 1) / kBlock * kBlock;
+            below      = level;
+            belowSize  = levelSize;
+            belowShift = 0;
+        }
+    }
+
+    // Position of the first element not less than value (size() if none), like std::lower_bound
+    size_type lower_bound(const T &value) const                             { return search(value, [this](const T &element, const T &v) { return mLess(element, v); });  }
+    // Position of the first element greater than value (size() if none), like std::upper_bound
+    size_type upper_bound(const T &value) const                             { return search(value, [this](const T &element, const T &v) { return !mLess(v, element); }); }
+
+    std::pair<size_type, size_type>
+              equal_range(const T &value) const                             { return { lower_bound(value), upper_bound(value) };            }
+
+    // output[i] = lower_bound(queries[i]). The searches of a batch of queries go down the levels together,
+    // and each one prefetches its next block, so their cache misses overlap.
+    template <class Queries, class Output>
+    void      lower_bound_many(const Queries &queries, Output firstOutput) const {
+        auto      before = [this](const T &element, const T &v) { return mLess(element, v); };
+        size_type blocks[detail::kSearchBatch];
+        for (size_type start = 0; start < size_type(queries.size()); start += detail::kSearchBatch) {
+            const size_type count = std::min(detail::kSearchBatch, size_type(queries.size()) - start);
+            for (size_type j = 0; j < count; ++j)
+                blocks[j] = 0;
+
+            for (size_type l = mLevels.size(); l-- > 0;) {
+                for (size_type j = 0; j < count; ++j) {
+                    if (blocks[j] == npos)
+                        continue;
+                    const size_type pos = levelPosition(l, blocks[j], queries[start + j], before);
+                    blocks[j] = (pos == mLevels[l].size) ? npos : pos;
+                    if (pos != mLevels[l].size)
+                        detail::prefetch(child(l, pos));
+                }
+            }
+
+            for (size_type j = 0; j < count; ++j)
+                firstOutput[start + j] = (blocks[j] == npos) ? mSize : dataPosition(blocks[j], queries[start + j], before);
+        }
+    }
+
+    // Position of an element equal to value, or npos
+    size_type find(const T &value) const {
+        size_type pos = lower_bound(value);
+        return (pos < mSize && !mLess(value, mData[pos])) ? pos : npos;
+    }
+    bool      contains(const T &value) const                                { return find(value) != npos;                                   }
+
+    size_type size() const                                                  { return mSize;                                                 }
+    bool      empty() const                                                 { return mSize == 0;                                            }
+    // Number of levels above the data
+    size_type levels() const                                                { return mLevels.size();                                        }
+
+protected:
+    static constexpr size_t kLine = 64;
+
+    struct Level {
+        size_type   offset;     // In mStorage
+        size_type   size;
+    };
+
+    // Number of elements of [first, last) for which before(element, value) is true (they are a prefix)
+    template <class Before>
+    static size_type countBefore(const T *first, const T *last, const T &value, Before &before) {
+        size_type n = 0;
+        for (; first != last; ++first)
+            n += size_type(before(*first, value));
+        return n;
+    }
+
+    // Position in level l of the first separator of block not before value (the block of the level below)
+    template <class Before>
+    size_type levelPosition(size_type l, size_type block, const T &value, Before &before) const {
+        const T         *level = mStorage.data() + mLevels[l].offset;
+        const size_type first  = block * kBlock;
+        const size_type last   = std::min(first + kBlock, mLevels[l].size);
+        return first + countBefore(level + first, level + last, value, before);
+    }
+
+    // Position in the data (data blocks are shifted mShift elements)
+    template <class Before>
+    size_type dataPosition(size_type block, const T &value, Before &before) const {
+        const size_type first = (block * kBlock > mShift) ? block * kBlock - mShift : 0;
+        const size_type last  = std::min((block + 1) * kBlock - mShift, mSize);
+        return first + countBefore(mData + first, mData + last, value, before);
+    }
+
+    // First element of block pos of the level below level l (the data below level 0)
+    const T * child(size_type l, size_type pos) const {
+        if (l > 0)
+            return mStorage.data() + mLevels[l - 1].offset + pos * kBlock;
+        return mData + ((pos * kBlock > mShift) ? pos * kBlock - mShift : 0);
+    }
+
+    template <class Before>
+    size_type search(const T &value, Before before) const {
+        // The block of each level is the position found in the level above. It is prefetched while the
+        // loop computes the bounds of the next step.
+        size_type block = 0;
+        for (size_type l = mLevels.size(); l-- > 0;) {
+            const size_type pos = levelPosition(l, block, value, before);
+            if (pos == mLevels[l].size)
+                return mSize;       // Only in the top level: every element is before value
+            detail::prefetch(child(l, pos));
+            block = pos;
+        }
+        return dataPosition(block, value, before);
+    }
+
+protected:
+    const T             *mData  = nullptr;
+    size_type           mSize   = 0;
+    size_type           mShift  = 0;
+    Less                mLess   {};
+    std::vector<T>      mStorage;
+    std::vector<Level>  mLevels;
+};
+
+// TVector members (declared in core_TVector.h)
+//-------------------------------------
+template <class T, class Allocator>
+template <class Less>
+TSearchIndex<T, Less>
+TVector<T, Allocator>::build_search_index(Less less) const {
+    TVECTOR_TRACE_SCOPE("build_search_index", size(), -1);
+    return TSearchIndex<T, Less>(data(), size(), less);
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Queries, class Output, class Less>
+const TVector<T, Allocator> &
+TVector<T, Allocator>::lower_bound_many(const Queries &queries, Output firstOutput, Less less) const {
+    TVECTOR_TRACE_SCOPE("lower_bound_many", queries.size(), -1);
+    detail::lowerBoundBatch(data(), size(), queries, 0, queries.size(), less, [&firstOutput](size_t i, size_t pos) {
+        firstOutput[i] = pos;
+    });
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Queries, class Output, class Less>
+const TVector<T, Allocator> &
+TVector<T, Allocator>::binary_search_many(const Queries &queries, Output firstOutput, Less less) const {
+    TVECTOR_TRACE_SCOPE("binary_search_many", queries.size(), -1);
+    const T         *items = data();
+    const size_type n      = size();
+    detail::lowerBoundBatch(items, n, queries, 0, queries.size(), less, [&](size_t i, size_t pos) {
+        firstOutput[i] = (pos < n) && !less(queries[i], items[pos]);
+    });
+    return *this;
+}
+
+} // end of namespace
@@ -0,0 +1,352 @@
+#pragma once
+
+//-------------------------------------
+// Set operations and k-way merge on sorted TVectors (declared in core_TVector.h).
+// Results are reserved up front instead of growing through back_inserter.
+// When one side is kGallopRatio times smaller than the other, intersections walk the small side and
+// find each element in the big one with exponential (galloping) search: O(m log(n / m)) instead of O(n + m).
+//-------------------------------------
+
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "core_TVector.h"
+
+namespace MindShake {
+
+namespace detail {
+
+    constexpr size_t kGallopRatio = 16;
+
+    //---------------------------------
+    // lower_bound in [first, last) probing 1, 2, 4, ... elements ahead: O(log distance to the result)
+    template <class Iterator, class Value, class Less>
+    inline Iterator
+    gallopLowerBound(Iterator first, Iterator last, const Value &value, Less &less) {
+        const size_t n     = size_t(last - first);
+        size_t       bound = 1;
+        while (bound < n && less(first[bound], value))
+            bound *= 2;
+
+        return std::lower_bound(first + (bound / 2), first + std::min(bound, n), value, less);
+    }
+
+    //---------------------------------
+    // Calls emit(it1) for every element of [first1, last1) that is also in [first2, last2)
+    template <class Iterator1, class Iterator2, class Less, class Emit>
+    inline void
+    intersectSorted(Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2, Less &less, Emit &&emit) {
+        const size_t n1 = size_t(last1 - first1);
+        const size_t n2 = size_t(last2 - first2);
+
+        if (n1 * kGallopRatio < n2) {
+            for (; first1 != last1 && first2 != last2; ++first1) {
+                first2 = gallopLowerBound(first2, last2, *first1, less);
+                if (first2 != last2 && !less(*first1, *first2)) {
+                    emit(first1);
+                    ++first2;
+                }
+            }
+        }
+        else if (n2 * kGallopRatio < n1) {
+            for (; first2 != last2 && first1 != last1; ++first2) {
+                first1 = gallopLowerBound(first1, last1, *first2, less);
+                if (first1 != last1 && !less(*first2, *first1)) {
+                    emit(first1);
+                    ++first1;
+                }
+            }
+        }
+        else {
+            while (first1 != last1 && first2 != last2) {
+                if (less(*first1, *first2))
+                    ++first1;
+                else if (less(*first2, *first1))
+                    ++first2;
+                else {
+                    emit(first1);
+                    ++first1;
+                    ++first2;
+                }
+            }
+        }
+    }
+
+    //---------------------------------
+    // Current element of every run in a k-way merge: a copy when it is small and trivially copyable
+    // (one dependent load less per match), or read through the head of the run.
+    template <class T, bool Copy = std::is_trivially_copyable<T>::value && (sizeof(T) <= 16)>
+    struct MergeKeys {
+        std::vector<T> keys;
+
+        void init(const std::vector<const T *> &heads)                      { keys.clear(); for (const T *head : heads) keys.push_back(*head); }
+        void update(size_t run, const T *head)                              { keys[run] = *head;                                            }
+        const T & operator()(size_t run) const                              { return keys[run];                                             }
+    };
+
+    template <class T>
+    struct MergeKeys<T, false> {
+        const T *const *heads = nullptr;
+
+        void init(const std::vector<const T *> &runHeads)                   { heads = runHeads.data();                                      }
+        void update(size_t, const T *)                                      {                                                               }
+        const T & operator()(size_t run) const                              { return *heads[run];                                           }
+    };
+
+    //---------------------------------
+    // Stable k-way merge of [first, last) ranges with a loser tree: every element costs log2(k) comparisons.
+    // Each internal node keeps the loser of its match, so only the path of the last winner is replayed.
+    // The replay selects with masks instead of branches (the comparisons are unpredictable), and exhausted
+    // runs stay in the tree as dead leaves (pointing to their last element) that never win.
+    template <class T, class Less, class Output>
+    inline Output
+    mergeRuns(std::vector<std::pair<const T *, const T *>> &runs, Less &less, Output out) {
+        runs.erase(std::remove_if(runs.begin(), runs.end(), [](const std::pair<const T *, const T *> &run) { return run.first == run.second; }), runs.end());
+
+        const size_t k = runs.size();
+        if (k == 0)
+            return out;
+        if (k == 1)
+            return std::copy(runs[0].first, runs[0].second, out);
+        if (k == 2)
+            return std::merge(runs[0].first, runs[0].second, runs[1].first, runs[1].second, out, less);
+
+        // Leaf i is run i, so the left subtree of a node always holds the earlier runs
+        size_t leaves = 1;
+        while (leaves < k)
+            leaves *= 2;
+
+        size_t                 total = 0;
+        std::vector<const T *> heads(leaves, runs[0].first);
+        std::vector<const T *> ends(leaves, runs[0].first);
+        std::vector<size_t>    alive(leaves, 0);
+        for (size_t i = 0; i < k; ++i) {
+            heads[i] = runs[i].first;
+            ends[i]  = runs[i].second;
+            alive[i] = 1;
+            total   += size_t(ends[i] - heads[i]);
+        }
+
+        MergeKeys<T> key;
+        key.init(heads);
+
+        std::vector<size_t> losers(leaves);
+        std::vector<size_t> winners(2 * leaves);
+        for (size_t i = 0; i < leaves; ++i)
+            winners[leaves + i] = i;
+        for (size_t node = leaves - 1; node >= 1; --node) {
+            size_t left      = winners[2 * node];
+            size_t right     = winners[2 * node + 1];
+            bool   rightWins = alive[right] && (!alive[left] || less(key(right), key(left)));
+            winners[node] = rightWins ? right : left;
+            losers[node]  = rightWins ? left : right;
+        }
+
+        size_t winner      = winners[1];
+        size_t winnerAlive = 1;
+        for (size_t i = 0; i < total; ++i) {
+            *out = key(winner);
+            ++out;
+            if (heads[winner] + 1 == ends[winner]) {
+                alive[winner] = 0;
+                winnerAlive   = 0;
+            }
+            else {
+                key.update(winner, ++heads[winner]);
+            }
+
+            size_t child = winner + leaves;
+            for (size_t node = child / 2; node >= 1; child = node, node /= 2) {
+                // The loser beats the winner if it is smaller, or equal and from an earlier run (the left child)
+                const size_t loser      = losers[node];
+                const size_t loserAlive = alive[loser];
+                const size_t fromLeft   = size_t(child & 1) - 1;                // All ones if the winner comes from the left
+                const size_t operands   = (loser ^ winner) & fromLeft;
+                const bool   smaller    = bool(less(key(winner ^ operands), key(loser ^ operands)));
+                const size_t beats      = loserAlive & ((winnerAlive ^ 1) | size_t(smaller == bool(fromLeft & 1)));
+                const size_t exchange   = (loser ^ winner) & (size_t(0) - beats);
+                losers[node] = loser ^ exchange;
+                winner      ^= exchange;
+                winnerAlive |= beats;
+            }
+        }
+        return out;
+    }
+
+} // end of namespace detail
+
+// TVector members (declared in core_TVector.h)
+//-------------------------------------
+template <class T, class Allocator>
+template <class Less>
+TVector<T, Allocator>
+TVector<T, Allocator>::set_union(const vector &other, Less less) const {
+    TVECTOR_TRACE_SCOPE("set_union", size() + other.size(), -1);
+    tvector result;
+    result.reserve(size() + other.size());
+    std::set_union(cbegin(), cend(), other.cbegin(), other.cend(), std::back_inserter(result), less);
+    return result;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Less>
+TVector<T, Allocator>
+TVector<T, Allocator>::set_intersection(const vector &other, Less less) const {
+    TVECTOR_TRACE_SCOPE("set_intersection", size() + other.size(), -1);
+    tvector result;
+    result.reserve(std::min(size(), other.size()));
+    detail::intersectSorted(cbegin(), cend(), other.cbegin(), other.cend(), less, [&result](const_iterator it) { result.push_back(*it); });
+    return result;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Less>
+TVector<T, Allocator>
+TVector<T, Allocator>::set_difference(const vector &other, Less less) const {
+    TVECTOR_TRACE_SCOPE("set_difference", size() + other.size(), -1);
+    tvector result;
+    result.reserve(size());
+    std::set_difference(cbegin(), cend(), other.cbegin(), other.cend(), std::back_inserter(result), less);
+    return result;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Less>
+TVector<T, Allocator>
+TVector<T, Allocator>::set_symmetric_difference(const vector &other, Less less) const {
+    TVECTOR_TRACE_SCOPE("set_symmetric_difference", size() + other.size(), -1);
+    tvector result;
+    result.reserve(size() + other.size());
+    std::set_symmetric_difference(cbegin(), cend(), other.cbegin(), other.cend(), std::back_inserter(result), less);
+    return result;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Less>
+typename TVector<T, Allocator>::size_type
+TVector<T, Allocator>::intersect_count(const vector &other, Less less) const {
+    TVECTOR_TRACE_SCOPE("intersect_count", size() + other.size(), -1);
+    size_type count = 0;
+    detail::intersectSorted(cbegin(), cend(), other.cbegin(), other.cend(), less, [&count](const_iterator) { ++count; });
+    return count;
+}
+
+//-------------------------------------
+// The elements of other missing here are appended and both sorted runs are merged
+template <class T, class Allocator>
+template <class Less>
+TVector<T, Allocator> &
+TVector<T, Allocator>::set_union_with(const vector &other, Less less) & {
+    TVECTOR_TRACE_SCOPE("set_union_with", size() + other.size(), -1);
+    if (&other == this)
+        return *this;
+
+    const size_type middle = size();
+    reserve(size() + other.size());     // back_inserter must not reallocate while reading the first run
+    std::set_difference(other.cbegin(), other.cend(), cbegin(), cbegin() + middle, std::back_inserter(*this), less);
+    std::inplace_merge(begin(), begin() + middle, end(), less);
+    return *this;
+}
+
+//-------------------------------------
+// Compacts the common elements at the front: no allocations
+template <class T, class Allocator>
+template <class Less>
+TVector<T, Allocator> &
+TVector<T, Allocator>::set_intersection_with(const vector &other, Less less) & {
+    TVECTOR_TRACE_SCOPE("set_intersection_with", size() + other.size(), -1);
+    if (&other == this)
+        return *this;
+
+    iterator out = begin();
+    detail::intersectSorted(begin(), end(), other.cbegin(), other.cend(), less, [&out](iterator it) {
+        if (it != out)
+            *out = std::move(*it);
+        ++out;
+    });
+    erase(out, end());
+    return *this;
+}
+
+//-------------------------------------
+// Compacts the elements missing in other at the front: no allocations
+template <class T, class Allocator>
+template <class Less>
+TVector<T, Allocator> &
+TVector<T, Allocator>::set_difference_with(const vector &other, Less less) & {
+    TVECTOR_TRACE_SCOPE("set_difference_with", size() + other.size(), -1);
+    if (&other == this)
+        return clear();
+
+    const bool     gallop = size() * detail::kGallopRatio < other.size();
+    const_iterator first2 = other.cbegin();
+    const_iterator last2  = other.cend();
+    iterator       out    = begin();
+    for (iterator it = begin(); it != end(); ++it) {
+        if (gallop)
+            first2 = detail::gallopLowerBound(first2, last2, *it, less);
+        else {
+            while (first2 != last2 && less(*first2, *it))
+                ++first2;
+        }
+
+        if (first2 != last2 && !less(*it, *first2)) {
+            ++first2;       // In both: removed
+            continue;
+        }
+
+        if (it != out)
+            *out = std::move(*it);
+        ++out;
+    }
+    erase(out, end());
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Less>
+TVector<T, Allocator> &
+TVector<T, Allocator>::set_symmetric_difference_with(const vector &other, Less less) & {
+    TVECTOR_TRACE_SCOPE("set_symmetric_difference_with", size() + other.size(), -1);
+    if (&other == this)
+        return clear();
+
+    tvector onlyOther;
+    onlyOther.reserve(other.size());
+    std::set_difference(other.cbegin(), other.cend(), cbegin(), cend(), std::back_inserter(onlyOther), less);
+    set_difference_with(other, less);
+
+    const size_type middle = size();
+    insert(end(), std::make_move_iterator(onlyOther.begin()), std::make_move_iterator(onlyOther.end()));
+    std::inplace_merge(begin(), begin() + middle, end(), less);
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Runs, class Less>
+TVector<T, Allocator>
+TVector<T, Allocator>::merge_sorted(const Runs &runs, Less less) {
+    std::vector<std::pair<const T *, const T *>> ranges;
+    size_type                                    total = 0;
+    for (const auto &run : runs) {
+        ranges.emplace_back(run.data(), run.data() + run.size());
+        total += run.size();
+    }
+
+    TVECTOR_TRACE_SCOPE("merge_sorted", total, -1);
+    tvector result;
+    result.reserve(total);
+    detail::mergeRuns(ranges, less, std::back_inserter(result));
+    return result;
+}
+
+} // end of namespace
@@ -0,0 +1,333 @@
+#pragma once
+
+//-------------------------------------
+// TVector sorting by a computed key and permutations (declared in core_TVector.h).
+// Every key is computed once into a scratch array of (key, index) pairs, the pairs are sorted
+// (LSD radix sort when the key is an integer or a float/double) and the permutation is applied.
+// Float keys follow the IEEE total order: -NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN.
+// argsort returns that permutation, and apply_permutation applies one in place.
+// top_k selects the k largest elements without sorting the whole vector.
+//-------------------------------------
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "core_TVector.h"
+
+namespace MindShake {
+
+namespace detail {
+
+    //---------------------------------
+    template <class Key, class Index>
+    struct KeyIndex {
+        Key     key;
+        Index   index;
+    };
+
+    // Keys that can be radix sorted: integers (not bool) and 32/64 bit floating point
+    template <class Key>
+    using IsRadixKey = std::integral_constant<bool,
+        (std::is_integral<Key>::value && !std::is_same<Key, bool>::value && sizeof(Key) <= 8) ||
+        (std::is_floating_point<Key>::value && (sizeof(Key) == 4 || sizeof(Key) == 8) && std::numeric_limits<Key>::is_iec559)>;
+
+    template <size_t Size> struct UnsignedOfSize;
+    template <> struct UnsignedOfSize<1> { using type = uint8_t;  };
+    template <> struct UnsignedOfSize<2> { using type = uint16_t; };
+    template <> struct UnsignedOfSize<4> { using type = uint32_t; };
+    template <> struct UnsignedOfSize<8> { using type = uint64_t; };
+
+    //---------------------------------
+    // Maps a key to an unsigned integer with the same order
+    template <class Key>
+    using RadixBits = typename UnsignedOfSize<sizeof(Key)>::type;
+
+    template <class Key>
+    inline RadixBits<Key>
+    radixBits(Key key, std::true_type /*isFloat*/) {
+        using Bits = RadixBits<Key>;
+        const Bits sign = Bits(1) << (sizeof(Key) * 8 - 1);
+
+        Bits bits;
+        memcpy(&bits, &key, sizeof(key));
+        // Negative: reverse the order of the magnitude. Positive: above every negative. (-0 goes before +0)
+        return (bits & sign) ? Bits(~bits) : Bits(bits | sign);
+    }
+
+    template <class Key>
+    inline RadixBits<Key>
+    radixBits(Key key, std::false_type /*isFloat*/) {
+        using Bits = RadixBits<Key>;
+        const Bits sign = std::is_signed<Key>::value ? Bits(Bits(1) << (sizeof(Key) * 8 - 1)) : Bits(0);
+        return Bits(Bits(key) ^ sign);
+    }
+
+    //---------------------------------
+    // Stable LSD radix sort, one byte per pass. Passes where every element has the same byte are skipped.
+    template <class Bits, class Index>
+    inline void
+    radixSort(std::vector<KeyIndex<Bits, Index>> &items) {
+        constexpr size_t kPasses = sizeof(Bits);
+        const size_t     n       = items.size();
+        if (n < 2)
+            return;
+
+        size_t counts[kPasses][256] = {};
+        for (const auto &item : items) {
+            for (size_t pass = 0; pass < kPasses; ++pass)
+                ++counts[pass][(item.key >> (pass * 8)) & 0xff];
+        }
+
+        std::vector<KeyIndex<Bits, Index>> buffer(n);
+        for (size_t pass = 0; pass < kPasses; ++pass) {
+            size_t *count = counts[pass];
+            if (count[(items[0].key >> (pass * 8)) & 0xff] == n)
+                continue;
+
+            size_t offset = 0;
+            for (size_t b = 0; b < 256; ++b) {
+                size_t c = count[b];
+                count[b] = offset;
+                offset  += c;
+            }
+
+            for (const auto &item : items)
+                buffer[count[(item.key >> (pass * 8)) & 0xff]++] = item;
+            items.swap(buffer);
+        }
+    }
+
+    //---------------------------------
+    // Fills order with the indices of values sorted by key
+    template <class Index, class T, class KeyFn>
+    inline void
+    sortedOrderByKey(const T *values, size_t n, KeyFn &keyFn, bool /*stable*/, std::vector<Index> &order, std::true_type /*radix*/) {
+        using Key  = typename std::decay<decltype(keyFn(values[0]))>::type;
+        using Bits = RadixBits<Key>;
+
+        std::vector<KeyIndex<Bits, Index>> items(n);
+        for (size_t i = 0; i < n; ++i)
+            items[i] = { radixBits(Key(keyFn(values[i])), std::is_floating_point<Key> {}), Index(i) };
+
+        radixSort(items);   // Always stable
+
+        order.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            order[i] = items[i].index;
+    }
+
+    template <class Index, class T, class KeyFn>
+    inline void
+    sortedOrderByKey(const T *values, size_t n, KeyFn &keyFn, bool stable, std::vector<Index> &order, std::false_type /*radix*/) {
+        using Key = typename std::decay<decltype(keyFn(values[0]))>::type;
+
+        std::vector<KeyIndex<Key, Index>> items;
+        items.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            items.push_back({ keyFn(values[i]), Index(i) });
+
+        auto less = [](const KeyIndex<Key, Index> &a, const KeyIndex<Key, Index> &b) { return a.key < b.key; };
+        if (stable)
+            std::stable_sort(items.begin(), items.end(), less);
+        else
+            std::sort(items.begin(), items.end(), less);
+
+        order.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            order[i] = items[i].index;
+    }
+
+    //---------------------------------
+    // Fills order with the indices of values sorted with less (stable)
+    template <class Index, class T, class Less>
+    inline void
+    sortedOrder(const T *values, size_t n, Less & /*less*/, std::vector<Index> &order, std::true_type /*radix*/) {
+        auto identity = [](const T &value) { return value; };
+        sortedOrderByKey(values, n, identity, true, order, std::true_type {});
+    }
+
+    template <class Index, class T, class Less>
+    inline void
+    sortedOrder(const T *values, size_t n, Less &less, std::vector<Index> &order, std::false_type /*radix*/) {
+        order.resize(n);
+        std::iota(order.begin(), order.end(), Index(0));
+        std::stable_sort(order.begin(), order.end(), [values, &less](Index a, Index b) { return less(values[a], values[b]); });
+    }
+
+    // Integers sorted with std::less can be radix sorted (floats not: std::less does not order -0 and +0)
+    template <class T, class Less>
+    using IsRadixSort = std::integral_constant<bool,
+        std::is_integral<T>::value && IsRadixKey<T>::value && std::is_same<Less, std::less<T>>::value>;
+
+    //---------------------------------
+    template <class Index, class Vector, class KeyFn>
+    inline void
+    sortByKey(Vector &values, KeyFn &keyFn, bool stable) {
+        using T   = typename Vector::value_type;
+        using Key = typename std::decay<decltype(keyFn(std::declval<const T &>()))>::type;
+
+        std::vector<Index> order;
+        sortedOrderByKey(values.data(), values.size(), keyFn, stable, order, IsRadixKey<Key> {});
+
+        // Gather (moving) into a new buffer, from the allocator of values (they are swapped)
+        typename Vector::vector sorted(values.get_allocator());
+        sorted.reserve(values.size());
+        for (Index i : order)
+            sorted.push_back(std::move(values.data()[i]));
+        values.swap(sorted);
+    }
+
+    //---------------------------------
+    // Appends to out the k largest elements of [first, last) by less, from the largest down
+    template <class Vector, class Iterator, class Less>
+    inline void
+    topK(Iterator first, Iterator last, size_t k, Less &less, Vector &out) {
+        const size_t n = size_t(std::distance(first, last));
+        k = std::min(k, n);
+        if (k == 0)
+            return;
+
+        auto greater = [&less](const auto &a, const auto &b) { return less(b, a); };
+        size_t start = out.size();
+        if (k * 8 >= n) {
+            // Big k: selection on a copy, O(n)
+            out.insert(out.end(), first, last);
+            std::nth_element(out.begin() + start, out.begin() + start + (k - 1), out.end(), greater);
+            out.resize(start + k);
+            std::sort(out.begin() + start, out.end(), greater);
+            return;
+        }
+
+        // Small k: heap with the k largest seen so far, the smallest of them on top
+        out.reserve(start + k);
+        for (; first != last; ++first) {
+            if (out.size() - start < k) {
+                out.push_back(*first);
+                std::push_heap(out.begin() + start, out.end(), greater);
+            }
+            else if (less(out[start], *first)) {
+                std::pop_heap(out.begin() + start, out.end(), greater);
+                out.back() = *first;
+                std::push_heap(out.begin() + start, out.end(), greater);
+            }
+        }
+        std::sort_heap(out.begin() + start, out.end(), greater);
+    }
+
+} // end of namespace detail
+
+// TVector members (declared in core_TVector.h)
+//-------------------------------------
+template <class T, class Allocator>
+template <class KeyFn>
+TVector<T, Allocator> &
+TVector<T, Allocator>::sort_by(KeyFn keyFn) & {
+    TVECTOR_TRACE_SCOPE("sort_by", size(), -1);
+    if (size() < 2)
+        return *this;
+
+    if (size() <= std::numeric_limits<uint32_t>::max())
+        detail::sortByKey<uint32_t>(*this, keyFn, false);
+    else
+        detail::sortByKey<size_t>(*this, keyFn, false);
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class KeyFn>
+TVector<T, Allocator> &
+TVector<T, Allocator>::stable_sort_by(KeyFn keyFn) & {
+    TVECTOR_TRACE_SCOPE("stable_sort_by", size(), -1);
+    if (size() < 2)
+        return *this;
+
+    if (size() <= std::numeric_limits<uint32_t>::max())
+        detail::sortByKey<uint32_t>(*this, keyFn, true);
+    else
+        detail::sortByKey<size_t>(*this, keyFn, true);
+    return *this;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Less>
+TVector<T, Allocator>
+TVector<T, Allocator>::top_k(size_type k, Less less) const {
+    TVECTOR_TRACE_SCOPE("top_k", size(), -1);
+    tvector result;
+    detail::topK(cbegin(), cend(), k, less, result);
+    return result;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Index, class Less>
+TVector<Index>
+TVector<T, Allocator>::argsort(Less less) const {
+    TVECTOR_TRACE_SCOPE("argsort", size(), -1);
+    TVector<Index> order;
+    detail::sortedOrder(data(), size(), less, order, detail::IsRadixSort<T, Less> {});
+    return order;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Index, class KeyFn>
+TVector<Index>
+TVector<T, Allocator>::argsort_by(KeyFn keyFn) const {
+    using Key = typename std::decay<decltype(keyFn(std::declval<const T &>()))>::type;
+
+    TVECTOR_TRACE_SCOPE("argsort_by", size(), -1);
+    TVector<Index> order;
+    detail::sortedOrderByKey(data(), size(), keyFn, true, order, detail::IsRadixKey<Key> {});
+    return order;
+}
+
+//-------------------------------------
+template <class T, class Allocator>
+template <class Index, class IndexAllocator>
+TVector<T, Allocator> &
+TVector<T, Allocator>::apply_permutation(const std::vector<Index, IndexAllocator> &perm) & {
+    TVECTOR_TRACE_SCOPE("apply_permutation", size(), -1);
+    if (perm.size() != size())
+        throw std::invalid_argument("apply_permutation: the permutation and the vector must have the same size");
+
+    const size_type   n      = size();
+    T                 *items = data();
+    std::vector<bool> placed(n, false);
+
+    // Every index in range and only once, or a cycle would not return to its start
+    for (size_type i = 0; i < n; ++i) {
+        const size_type index = size_type(perm[i]);
+        if (index >= n || placed[index])
+            throw std::invalid_argument("apply_permutation: perm must contain each index from 0 to size() - 1 once");
+        placed[index] = true;
+    }
+    placed.assign(n, false);
+
+    for (size_type start = 0; start < n; ++start) {
+        if (placed[start])
+            continue;
+
+        // Gather along the cycle: items[i] = items[perm[i]]
+        T         first   = std::move(items[start]);
+        size_type current = start;
+        placed[start] = true;
+        for (size_type next = size_type(perm[current]); next != start; next = size_type(perm[current])) {
+            items[current] = std::move(items[next]);
+            placed[next]   = true;
+            current        = next;
+        }
+        items[current] = std::move(first);
+    }
+    return *this;
+}
+
+} // end of namespace
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//-------------------------------------
+// Allocation telemetry for TVector.
+// Define TVECTOR_TELEMETRY in the whole program (CMake option TVECTOR_ENABLE_TELEMETRY) to enable it.
+// Without it TVector does not record anything and the macros below are empty.
+//
+// Statistics are aggregated by tag. The tag is selected per thread with a scope:
+//   TVECTOR_TELEMETRY_SCOPE("parser");  // Everything done by this thread until the end of the scope
+//   TVECTOR_TELEMETRY_SITE();           // Same, using "file:line" as tag
+//-------------------------------------
+
+#if defined(TVECTOR_TELEMETRY)
+    #define TVECTOR_TELEMETRY_CONCAT2(a, b) a##b
+    #define TVECTOR_TELEMETRY_CONCAT(a, b)  TVECTOR_TELEMETRY_CONCAT2(a, b)
+    #define TVECTOR_TELEMETRY_STR2(x)       #x
+    #define TVECTOR_TELEMETRY_STR(x)        TVECTOR_TELEMETRY_STR2(x)
+
+    #define TVECTOR_TELEMETRY_SCOPE(tag)    MindShake::TVectorTelemetryScope TVECTOR_TELEMETRY_CONCAT(tvectorTelemetryScope, __LINE__)(tag)
+    #define TVECTOR_TELEMETRY_SITE()        TVECTOR_TELEMETRY_SCOPE(__FILE__ ":" TVECTOR_TELEMETRY_STR(__LINE__))
+#else
+    #define TVECTOR_TELEMETRY_SCOPE(tag)
+    #define TVECTOR_TELEMETRY_SITE()
+#endif
+
+namespace MindShake {
+
+//-------------------------------------
+class TVectorTelemetry {
+public:
+    // Live counters of a tag
+    struct Stats {
+        std::atomic<uint64_t>   allocations       { 0 };    // Buffers allocated by growth (reallocations included)
+        std::atomic<uint64_t>   reallocations     { 0 };    // Growths that had to move the previous buffer
+        std::atomic<uint64_t>   bytesCopied       { 0 };    // Bytes moved/copied from the previous buffer on reallocation
+        std::atomic<uint64_t>   elementsShifted   { 0 };    // Elements moved by insert / emplace / erase in the middle
+        std::atomic<uint64_t>   peakCapacityBytes { 0 };    // Biggest buffer seen
+        std::atomic<uint64_t>   peakSlackBytes    { 0 };    // Biggest (capacity - size) seen after a growth
+    };
+
+    // Snapshot of a tag
+    struct Report {
+        std::string tag;
+        uint64_t    allocations;
+        uint64_t    reallocations;
+        uint64_t    bytesCopied;
+        uint64_t    elementsShifted;
+        uint64_t    peakCapacityBytes;
+        uint64_t    peakSlackBytes;
+    };
+
+public:
+    // Stats of the tag selected by the current thread
+    static Stats &  current()                                               { return *currentSlot();                                        }
+
+    static Stats & get(const std::string &tag) {
+        Registry &registry = instance();
+
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto &stats = registry.tags[tag];
+        if (stats == nullptr)
+            stats.reset(new Stats);
+        return *stats;
+    }
+
+    // Called by TVector
+    //---------------------------------
+    static void recordGrowth(size_t elementSize, size_t oldSize, size_t oldCapacity, size_t newSize, size_t newCapacity) {
+        if (newCapacity == oldCapacity)
+            return;
+
+        Stats &stats = current();
+        stats.allocations.fetch_add(1, std::memory_order_relaxed);
+        if (oldCapacity > 0) {
+            stats.reallocations.fetch_add(1, std::memory_order_relaxed);
+            stats.bytesCopied.fetch_add(uint64_t(oldSize) * elementSize, std::memory_order_relaxed);
+        }
+        atomicMax(stats.peakCapacityBytes, uint64_t(newCapacity) * elementSize);
+        atomicMax(stats.peakSlackBytes, uint64_t(newCapacity - newSize) * elementSize);
+    }
+
+    static void recordShift(size_t elements) {
+        if (elements > 0)
+            current().elementsShifted.fetch_add(elements, std::memory_order_relaxed);
+    }
+
+    // Reports
+    //---------------------------------
+    static std::vector<Report> snapshot() {
+        Registry            &registry = instance();
+        std::vector<Report> reports;
+
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto &pair : registry.tags) {
+            const Stats &s = *pair.second;
+            reports.push_back(Report {
+                pair.first,
+                s.allocations.load(std::memory_order_relaxed),
+                s.reallocations.load(std::memory_order_relaxed),
+                s.bytesCopied.load(std::memory_order_relaxed),
+                s.elementsShifted.load(std::memory_order_relaxed),
+                s.peakCapacityBytes.load(std::memory_order_relaxed),
+                s.peakSlackBytes.load(std::memory_order_relaxed),
+            });
+        }
+        return reports;
+    }
+
+    // [{"tag": "...", "allocations": n, ...}, ...]
+    static std::string to_json() {
+        std::string json = "[";
+        for (const Report &r : snapshot()) {
+            char buffer[512];
+            snprintf(buffer, sizeof(buffer),
+                "%s\n  {\"tag\": \"%s\", \"allocations\": %llu, \"reallocations\": %llu, \"bytes_copied\": %llu, "
+                "\"elements_shifted\": %llu, \"peak_capacity_bytes\": %llu, \"peak_slack_bytes\": %llu}",
+                (json.size() > 1) ? "," : "", escape(r.tag).c_str(),
+                (unsigned long long) r.allocations, (unsigned long long) r.reallocations, (unsigned long long) r.bytesCopied,
+                (unsigned long long) r.elementsShifted, (unsigned long long) r.peakCapacityBytes, (unsigned long long) r.peakSlackBytes);
+            json += buffer;
+        }
+        json += "\n]\n";
+        return json;
+    }
+
+    static void print(FILE *file = stdout) {
+        fprintf(file, "%-40s %12s %12s %14s %14s %14s %14s\n", "tag", "allocs", "reallocs", "bytes copied", "shifted", "peak cap (B)", "peak slack (B)");
+        for (const Report &r : snapshot()) {
+            fprintf(file, "%-40s %12llu %12llu %14llu %14llu %14llu %14llu\n", r.tag.c_str(),
+                (unsigned long long) r.allocations, (unsigned long long) r.reallocations, (unsigned long long) r.bytesCopied,
+                (unsigned long long) r.elementsShifted, (unsigned long long) r.peakCapacityBytes, (unsigned long long) r.peakSlackBytes);
+        }
+    }
+
+    // Sets all the counters to zero (tags are kept)
+    static void reset() {
+        Registry &registry = instance();
+
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto &pair : registry.tags) {
+            Stats &s = *pair.second;
+            s.allocations       = 0;
+            s.reallocations     = 0;
+            s.bytesCopied       = 0;
+            s.elementsShifted   = 0;
+            s.peakCapacityBytes = 0;
+            s.peakSlackBytes    = 0;
+        }
+    }
+
+protected:
+    friend class TVectorTelemetryScope;
+
+    struct Registry {
+        std::mutex                                      mutex;
+        std::map<std::string, std::unique_ptr<Stats>>   tags;
+    };
+
+    static Registry & instance() {
+        static Registry registry;
+        return registry;
+    }
+
+    static Stats *& currentSlot() {
+        static thread_local Stats *stats = &get("default");
+        return stats;
+    }
+
+    static void atomicMax(std::atomic<uint64_t> &target, uint64_t value) {
+        uint64_t prev = target.load(std::memory_order_relaxed);
+        while (prev < value && target.compare_exchange_weak(prev, value, std::memory_order_relaxed) == false) {
+        }
+    }
+
+    static std::string escape(const std::string &str) {
+        std::string out;
+        for (char c : str) {
+            if (c == '"' || c == '\\')
+                out += '\\';
+            out += c;
+        }
+        return out;
+    }
+};
+
+//-------------------------------------
+// Selects the tag of the current thread until the end of the scope
+class TVectorTelemetryScope {
+public:
+    explicit TVectorTelemetryScope(const std::string &tag)
+        : mPrevious(TVectorTelemetry::currentSlot()) {
+        TVectorTelemetry::currentSlot() = &TVectorTelemetry::get(tag);
+    }
+    ~TVectorTelemetryScope()                                                { TVectorTelemetry::currentSlot() = mPrevious;                  }
+
+    TVectorTelemetryScope(const TVectorTelemetryScope &)             = delete;
+    TVectorTelemetryScope & operator=(const TVectorTelemetryScope &) = delete;
+
+protected:
+    TVectorTelemetry::Stats  *mPrevious;
+};
+
+} // end of namespace
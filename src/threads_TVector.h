@@ -0,0 +1,264 @@
+#pragma once
+
+//-------------------------------------
+// The parts of the execution policies that need thread headers: the number of hardware threads,
+// ExecutionPolicy::automatic resolution, the global thresholds, cancellation tokens and the worker
+// pool shared by the parallel and the asynchronous algorithms.
+// Included by the headers that run on threads (algorithm, parallel and async), not by core_TVector.h.
+//-------------------------------------
+
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "policy_TVector.h"
+
+namespace MindShake {
+
+namespace detail {
+
+    //---------------------------------
+    inline size_t
+    hardwareThreads() {
+        static const size_t n = std::max<size_t>(1, std::thread::hardware_concurrency());
+        return n;
+    }
+
+    //---------------------------------
+    // Worker threads (one per hardware thread) taking tasks from a queue: the asynchronous algorithms in order,
+    // and the helpers of parallelFor first. Created on first use; at exit the queued tasks are finished before joining.
+    class WorkerPool {
+    public:
+        static WorkerPool & instance() {
+            static WorkerPool pool(hardwareThreads());
+            return pool;
+        }
+
+        void push(std::function<void()> task) {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mTasks.push_back(std::move(task));
+            }
+            mCondition.notify_one();
+        }
+
+        // copies of task before the queued ones
+        void pushFront(size_t copies, const std::function<void()> &task) {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                for (size_t c = 0; c < copies; ++c)
+                    mTasks.push_front(task);
+            }
+            if (copies == 1)
+                mCondition.notify_one();
+            else
+                mCondition.notify_all();
+        }
+
+        ~WorkerPool() {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStop = true;
+            }
+            mCondition.notify_all();
+            for (auto &worker : mWorkers)
+                worker.join();
+        }
+
+        WorkerPool(const WorkerPool &)             = delete;
+        WorkerPool & operator=(const WorkerPool &) = delete;
+
+    protected:
+        explicit WorkerPool(size_t numThreads) {
+            mWorkers.reserve(numThreads);
+            for (size_t t = 0; t < numThreads; ++t)
+                mWorkers.emplace_back([this]() { work(); });
+        }
+
+        void work() {
+            for (;;) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mMutex);
+                    mCondition.wait(lock, [this]() { return mStop || !mTasks.empty(); });
+                    if (mTasks.empty())
+                        return;
+                    task = std::move(mTasks.front());
+                    mTasks.pop_front();
+                }
+                task();
+            }
+        }
+
+    protected:
+        std::mutex                          mMutex;
+        std::condition_variable             mCondition;
+        std::deque<std::function<void()>>   mTasks;
+        std::vector<std::thread>            mWorkers;
+        bool                                mStop = false;
+    };
+
+
+    //---------------------------------
+    // State of a parallelFor, shared with its helpers: the ones that start after the loop ended find no index
+    // left and return without calling body (which refers to the caller's stack).
+    struct ParallelLoop {
+        std::function<void(size_t)> body;
+        size_t                      count   = 0;
+        std::atomic<size_t>         next    { 0 };
+        size_t                      running = 0;    // Helpers inside the loop
+        std::exception_ptr          error;
+        std::mutex                  mutex;
+        std::condition_variable     finished;
+
+        void run() {
+            try {
+                for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+                    body(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (error == nullptr)
+                    error = std::current_exception();
+                next.store(count);
+            }
+        }
+    };
+
+    //---------------------------------
+    // Calls func(i) for every i in [0, count) using up to numThreads threads: the caller and numThreads - 1 helpers
+    // queued first on the WorkerPool, taking the next i from a shared counter. The caller only waits for the helpers
+    // that took part, never for workers busy with other tasks, so a parallelFor inside func or inside an
+    // asynchronous task does not deadlock (it runs on fewer threads).
+    // The first exception thrown by func is rethrown once every thread has finished.
+    template <class Func>
+    inline void
+    parallelFor(size_t count, size_t numThreads, Func &&func) {
+        if (numThreads == 0)
+            numThreads = hardwareThreads();
+        numThreads = std::min(numThreads, count);
+
+        if (numThreads <= 1) {
+            for (size_t i = 0; i < count; ++i)
+                func(i);
+            return;
+        }
+
+        auto loop = std::make_shared<ParallelLoop>();
+        loop->body  = [&func](size_t i) { func(i); };
+        loop->count = count;
+        WorkerPool::instance().pushFront(numThreads - 1, [loop]() {
+            {
+                std::lock_guard<std::mutex> lock(loop->mutex);
+                if (loop->next.load() >= loop->count)
+                    return;
+                ++loop->running;
+            }
+            loop->run();
+
+            std::lock_guard<std::mutex> lock(loop->mutex);
+            if (--loop->running == 0)
+                loop->finished.notify_all();
+        });
+
+        loop->run();
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        loop->finished.wait(lock, [&loop]() { return loop->running == 0; });
+        if (loop->error != nullptr)
+            std::rethrow_exception(loop->error);
+    }
+
+} // end of namespace detail
+
+//-------------------------------------
+inline ExecutionThresholds &
+ExecutionThresholds::global() {
+    static ExecutionThresholds thresholds = []() {
+        ExecutionThresholds loaded;
+        const char *path = getenv("TVECTOR_THRESHOLDS");
+        if (path != nullptr)
+            loaded.load(path);
+        return loaded;
+    }();
+    return thresholds;
+}
+
+//-------------------------------------
+// Resolves ExecutionPolicy::automatic into seq or par. Other policies are returned as they are.
+// relativeCost is the cost of the operation per element compared with the one used to calibrate
+// (1 = an integer addition). Use a bigger value for expensive operations.
+inline ExecutionPolicy
+resolvePolicy(ExecutionPolicy policy, PolicyOperation op, size_t count, double relativeCost = 1.0,
+              const ExecutionThresholds &thresholds = ExecutionThresholds::global()) {
+    if (policy != ExecutionPolicy::automatic)
+        return policy;
+
+    if (detail::hardwareThreads() <= 1)
+        return ExecutionPolicy::seq;
+
+    return (double(count) * relativeCost >= double(thresholds.get(op))) ? ExecutionPolicy::par : ExecutionPolicy::seq;
+}
+
+namespace detail {
+
+    //---------------------------------
+    // relativeCost for resolvePolicy of an operation that is O(log n) per element (a search in n elements,
+    // or a sort of n): 1 + floor(log2(n)), so automatic weighs the transform threshold by log2(n)
+    inline double
+    log2Cost(size_t n) {
+        double cost = 1.0;
+        for (; n > 1; n >>= 1)
+            cost += 1.0;
+        return cost;
+    }
+
+} // end of namespace detail
+
+//-------------------------------------
+// Cooperative cancellation of long operations (the TVector overloads taking it check it between units of work).
+// Copies share the state: keep one and pass another to the operation. It is cancelled by cancel() or, if
+// it has one, when the deadline passes.
+//-------------------------------------
+class TCancellationToken {
+public:
+    using clock = std::chrono::steady_clock;
+
+public:
+    TCancellationToken() : mState(std::make_shared<State>()) { }
+    explicit TCancellationToken(clock::time_point deadline) : TCancellationToken() { mState->deadline = deadline; }
+
+    static TCancellationToken after(clock::duration timeout)               { return TCancellationToken(clock::now() + timeout);            }
+
+    void                cancel() const                                      { mState->cancelled.store(true, std::memory_order_relaxed);     }
+    clock::time_point   deadline() const                                    { return mState->deadline;                                      }
+
+    bool is_cancelled() const {
+        if (mState->cancelled.load(std::memory_order_relaxed))
+            return true;
+        if (mState->deadline != clock::time_point::max() && clock::now() >= mState->deadline) {
+            cancel();
+            return true;
+        }
+        return false;
+    }
+
+protected:
+    struct State {
+        std::atomic<bool>   cancelled { false };
+        clock::time_point   deadline  = clock::time_point::max();
+    };
+
+    std::shared_ptr<State> mState;
+};
+
+} // end of namespace
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//-------------------------------------
+// Timing hooks for TVector algorithms.
+// Define TVECTOR_TRACE in the whole program (CMake option TVECTOR_ENABLE_TRACE) to enable them.
+// Without it the hooks are empty macros and cost nothing.
+//
+// Every traced call (sort, filter, transform, reduce, for_each, ...) records its name, start, end,
+// number of elements, execution policy and thread into a lock-free ring buffer owned by the thread.
+// When a thread ends its buffer (and its last events) passes to the next thread that starts tracing, so
+// there are only as many buffers as threads tracing at the same time.
+// TVectorTrace::to_chrome_json() exports them as Chrome trace events (chrome://tracing, Perfetto).
+//-------------------------------------
+
+#if !defined(TVECTOR_TRACE_BUFFER_SIZE)
+    #define TVECTOR_TRACE_BUFFER_SIZE   8192    // Events per thread (power of two)
+#endif
+
+#if defined(TVECTOR_TRACE)
+    #define TVECTOR_TRACE_SCOPE(name, count, policy)  MindShake::TVectorTraceScope tvectorTraceScope(name, size_t(count), int(policy))
+#else
+    #define TVECTOR_TRACE_SCOPE(name, count, policy)
+#endif
+
+namespace MindShake {
+
+//-------------------------------------
+class TVectorTrace {
+public:
+    static constexpr int    kNoPolicy   = -1;
+    static constexpr size_t kBufferSize = TVECTOR_TRACE_BUFFER_SIZE;
+    static_assert((kBufferSize & (kBufferSize - 1)) == 0, "TVECTOR_TRACE_BUFFER_SIZE must be a power of two");
+
+    struct Event {
+        const char  *name;
+        uint64_t    startNs;
+        uint64_t    endNs;
+        uint64_t    count;
+        int         policy;     // ExecutionPolicy or kNoPolicy
+        uint32_t    thread;
+    };
+
+public:
+    static uint64_t now() {
+        static const auto epoch = std::chrono::steady_clock::now();
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+    }
+
+    // Called by TVectorTraceScope (only the owner thread writes in its buffer)
+    static void record(const char *name, uint64_t startNs, uint64_t endNs, size_t count, int policy) {
+        const ThreadOwner &owner  = threadOwner();
+        ThreadBuffer      &buffer = *owner.buffer;
+        uint64_t          pos     = buffer.head.load(std::memory_order_relaxed);
+        Slot         &slot   = buffer.slots[pos & (kBufferSize - 1)];
+
+        // Seqlock: odd while writing, so readers can discard torn events
+        slot.seq.store(2 * pos + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.startNs.store(startNs, std::memory_order_relaxed);
+        slot.endNs.store(endNs, std::memory_order_relaxed);
+        slot.count.store(count, std::memory_order_relaxed);
+        slot.policy.store(policy, std::memory_order_relaxed);
+        slot.thread.store(owner.thread, std::memory_order_relaxed);
+        slot.seq.store(2 * pos + 2, std::memory_order_release);
+
+        buffer.head.store(pos + 1, std::memory_order_release);
+    }
+
+    // Events still in the ring buffers of every thread (the oldest ones are overwritten)
+    static std::vector<Event> snapshot() {
+        Registry           &registry = instance();
+        std::vector<Event> events;
+
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto &buffer : registry.buffers) {
+            uint64_t head  = buffer->head.load(std::memory_order_acquire);
+            uint64_t first = (head > kBufferSize) ? head - kBufferSize : 0;
+            for (uint64_t pos = first; pos < head; ++pos) {
+                const Slot &slot = buffer->slots[pos & (kBufferSize - 1)];
+
+                uint64_t seq = slot.seq.load(std::memory_order_acquire);
+                Event    event {
+                    slot.name.load(std::memory_order_relaxed),
+                    slot.startNs.load(std::memory_order_relaxed),
+                    slot.endNs.load(std::memory_order_relaxed),
+                    slot.count.load(std::memory_order_relaxed),
+                    slot.policy.load(std::memory_order_relaxed),
+                    slot.thread.load(std::memory_order_relaxed),
+                };
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq == 2 * pos + 2 && slot.seq.load(std::memory_order_relaxed) == seq)
+                    events.push_back(event);
+            }
+        }
+        return events;
+    }
+
+    // Discards the recorded events
+    static void clear() {
+        Registry &registry = instance();
+
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto &buffer : registry.buffers) {
+            for (auto &slot : buffer->slots)
+                slot.seq.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Number of ring buffers (the most threads that were tracing at the same time)
+    static size_t buffer_count() {
+        Registry &registry = instance();
+
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        return registry.buffers.size();
+    }
+
+    static const char * policyName(int policy) {
+        switch (policy) {
+            case 0:  return "seq";
+            case 1:  return "par";
+            case 2:  return "par_unseq";
+            case 3:  return "unseq";
+            case 4:  return "automatic";
+            default: return "none";
+        }
+    }
+
+    // Chrome trace event format ("X" complete events, timestamps in microseconds)
+    static std::string to_chrome_json() {
+        std::string json = "{\"traceEvents\": [";
+        bool        first = true;
+        for (const Event &e : snapshot()) {
+            char buffer[512];
+            snprintf(buffer, sizeof(buffer),
+                "%s\n  {\"name\": \"%s\", \"cat\": \"TVector\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %u, "
+                "\"args\": {\"count\": %llu, \"policy\": \"%s\"}}",
+                first ? "" : ",", e.name, e.startNs / 1000.0, (e.endNs - e.startNs) / 1000.0, e.thread,
+                (unsigned long long) e.count, policyName(e.policy));
+            json += buffer;
+            first = false;
+        }
+        json += "\n], \"displayTimeUnit\": \"ns\"}\n";
+        return json;
+    }
+
+    static bool write_chrome_json(const char *path) {
+        FILE *file = fopen(path, "wb");
+        if (file == nullptr)
+            return false;
+
+        std::string json = to_chrome_json();
+        bool        ok   = fwrite(json.data(), 1, json.size(), file) == json.size();
+        return (fclose(file) == 0) && ok;
+    }
+
+protected:
+    struct Slot {
+        std::atomic<uint64_t>       seq     { 0 };
+        std::atomic<const char *>   name    { nullptr };
+        std::atomic<uint64_t>       startNs { 0 };
+        std::atomic<uint64_t>       endNs   { 0 };
+        std::atomic<uint64_t>       count   { 0 };
+        std::atomic<int>            policy  { kNoPolicy };
+        std::atomic<uint32_t>       thread  { 0 };
+    };
+
+    struct ThreadBuffer {
+        std::atomic<uint64_t>   head { 0 };
+        Slot                    slots[kBufferSize];
+    };
+
+    struct Registry {
+        std::mutex                                  mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>>  buffers;
+        std::vector<ThreadBuffer *>                 unused;     // Of threads that ended
+        uint32_t                                    lastThread = 0;
+    };
+
+    // Takes a buffer for the thread (an unused one if any) and gives it back when the thread ends
+    struct ThreadOwner {
+        ThreadBuffer    *buffer;
+        uint32_t        thread;
+
+        ThreadOwner() {
+            Registry &registry = instance();
+
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            if (registry.unused.empty()) {
+                registry.buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+                buffer = registry.buffers.back().get();
+            }
+            else {
+                buffer = registry.unused.back();
+                registry.unused.pop_back();
+            }
+            thread = ++registry.lastThread;
+        }
+
+        ~ThreadOwner() {
+            Registry &registry = instance();
+
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.unused.push_back(buffer);
+        }
+
+        ThreadOwner(const ThreadOwner &)             = delete;
+        ThreadOwner & operator=(const ThreadOwner &) = delete;
+    };
+
+    // Never destroyed: the ThreadOwner of a pool worker gives its buffer back when the pool is joined at exit,
+    // which can be after the destruction of the function-local statics built later than the pool
+    static Registry & instance() {
+        static Registry *registry = new Registry;
+        return *registry;
+    }
+
+    static const ThreadOwner & threadOwner() {
+        static thread_local ThreadOwner owner;
+        return owner;
+    }
+};
+
+//-------------------------------------
+class TVectorTraceScope {
+public:
+    TVectorTraceScope(const char *name, size_t count, int policy)
+        : mName(name), mCount(count), mPolicy(policy), mStart(TVectorTrace::now()) {
+    }
+    ~TVectorTraceScope()                                                    { TVectorTrace::record(mName, mStart, TVectorTrace::now(), mCount, mPolicy); }
+
+    TVectorTraceScope(const TVectorTraceScope &)             = delete;
+    TVectorTraceScope & operator=(const TVectorTraceScope &) = delete;
+
+protected:
+    const char  *mName;
+    size_t      mCount;
+    int         mPolicy;
+    uint64_t    mStart;
+};
+
+} // end of namespace
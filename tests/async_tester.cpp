@@ -0,0 +1,111 @@
+#include <doctest.h>
+#include <TVector.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace MindShake;
+
+#if defined(TVECTOR_COROUTINES)
+// Minimal coroutine that starts at once and is never awaited
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask        get_return_object()                             { return {};                                                    }
+        std::suspend_never  initial_suspend() noexcept                      { return {};                                                    }
+        std::suspend_never  final_suspend() noexcept                        { return {};                                                    }
+        void                return_void()                                   { }
+        void                unhandled_exception()                           { std::terminate();                                             }
+    };
+};
+
+static DetachedTask
+sumLater(const TVector<int> &values, std::atomic<int> &result) {
+    int sum = co_await values.reduce_async(0, [](int a, int b) { return a + b; });
+    result  = sum;
+}
+#endif
+
+//-------------------------------------
+TEST_CASE("TAsync") {
+    TVector<int> values(10000);
+    std::iota(values.begin(), values.end(), 0);
+    values.shuffle(Xoshiro256(5));
+
+    SUBCASE("In place and with the elements moved in") {
+        TVector<int> sorted = values;
+        auto         done   = sorted.sort_async();
+        done.wait();
+        CHECK(done.ready());
+        CHECK(std::is_sorted(sorted.begin(), sorted.end()));
+
+        TVector<int> descending = TVector<int>(values).sort_async(std::greater<int>()).get();
+        CHECK(descending.front() == 9999);
+
+        // Big enough for the parallel sort (with more than one hardware thread)
+        TVector<int> big(300000);
+        std::iota(big.begin(), big.end(), 0);
+        big.shuffle(Xoshiro256(7));
+        TVector<int> bigSorted = TVector<int>(big).sort_async().get();
+        big.sort_async(std::greater<int>()).get();
+        CHECK(std::is_sorted(bigSorted.begin(), bigSorted.end()));
+        CHECK(bigSorted[123456] == 123456);
+        CHECK(std::is_sorted(big.begin(), big.end(), std::greater<int>()));
+
+        TVector<int> doubled = values;
+        doubled.transform_async([](int v) { return v * 2; }).get();
+        CHECK(doubled[0] == values[0] * 2);
+        CHECK(TVector<int>(values).transform_async([](int v) { return -v; }).get()[1] == -values[1]);
+
+        CHECK(values.reduce_async(int64_t(0), [](int64_t a, int b) { return a + b; }).get() == int64_t(9999) * 10000 / 2);
+
+        auto even = [](int v) { return v % 2 == 0; };
+        CHECK(values.filter_async(even).get() == values.filter(even));
+        CHECK(TVector<int>(values).filter_async(even).get().size() == 5000);
+    }
+
+    SUBCASE("Callbacks and exceptions") {
+        std::atomic<bool> called { false };
+        auto              sum = values.reduce_async(0, [](int a, int b) { return a + b; });
+        sum.on_ready([&called]() { called = true; });
+        sum.wait();
+        while (called == false)     // The callback runs on the worker after the result is set
+            std::this_thread::yield();
+        CHECK(sum.get() == 9999 * 10000 / 2);
+
+        // Already ready: on the calling thread
+        called = false;
+        sum.on_ready([&called]() { called = true; });
+        CHECK(called);
+
+        auto failed = values.reduce_async(0, [](int a, int b) -> int { if (b == 77) throw std::runtime_error("77"); return a + b; });
+        CHECK_THROWS_AS(failed.get(), std::runtime_error);
+    }
+
+    SUBCASE("Parallel algorithms inside the tasks") {
+        // They share the workers with the tasks: every task does the work that busy workers cannot take
+        TVector<int> expected = values;
+        expected.shuffle(ExecutionPolicy::par, 9, 4);
+
+        std::vector<TAsync<TVector<int>>> tasks;
+        for (size_t t = 0; t < 4 * detail::hardwareThreads(); ++t) {
+            tasks.push_back(detail::runAsync<TVector<int>>([&values]() {
+                TVector<int> shuffled = values;
+                shuffled.shuffle(ExecutionPolicy::par, 9, 4);
+                return shuffled;
+            }));
+        }
+        for (auto &task : tasks)
+            CHECK(task.get() == expected);
+    }
+
+#if defined(TVECTOR_COROUTINES)
+    SUBCASE("co_await") {
+        std::atomic<int> result { -1 };
+        sumLater(values, result);
+        while (result == -1)
+            std::this_thread::yield();
+        CHECK(result == 9999 * 10000 / 2);
+    }
+#endif
+}
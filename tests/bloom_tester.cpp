@@ -0,0 +1,110 @@
+#include <doctest.h>
+#include <bloom_TVector.h>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace MindShake;
+
+//-------------------------------------
+TEST_CASE("TBloomFilter") {
+    SUBCASE("No false negatives, bounded false positives") {
+        const size_t            n = 100000;
+        TBloomFilter<uint64_t>  filter(n, 0.01);
+        for (uint64_t i = 0; i < n; ++i)
+            filter.insert(i * 3);
+
+        bool all = true;
+        for (uint64_t i = 0; i < n; ++i)
+            all &= filter.may_contain(i * 3);
+        CHECK(all);
+        CHECK(filter.size() == n);
+
+        size_t falsePositives = 0;
+        for (uint64_t i = 0; i < n; ++i)
+            falsePositives += filter.may_contain(i * 3 + 1);
+        CHECK(double(falsePositives) / double(n) < 0.015);
+        CHECK(filter.false_positive_rate() <= 0.01);
+
+        // A lower rate takes more memory
+        CHECK(TBloomFilter<uint64_t>(n, 0.001).bytes() > filter.bytes());
+    }
+
+    SUBCASE("False positive rate out of range") {
+        CHECK_THROWS_AS(TBloomFilter<int>(1000, 0.0), std::invalid_argument);
+        CHECK_THROWS_AS(TBloomFilter<int>(1000, -0.5), std::invalid_argument);
+        CHECK_THROWS_AS(TBloomFilter<int>(1000, 1.0), std::invalid_argument);
+        CHECK_THROWS_AS(TBloomFilter<int>(1000, std::nan("")), std::invalid_argument);
+        CHECK_THROWS_AS(TBloomVector<int>(0.0), std::invalid_argument);
+
+        // Tiny rates are capped, not endless
+        CHECK(TBloomFilter<int>(1000, 1e-300).bytes() > TBloomFilter<int>(1000, 1e-6).bytes());
+    }
+
+    SUBCASE("Copies and containers") {
+        TVector<std::string> words = { "alpha", "beta", "gamma" };
+        auto filter = TBloomFilter<std::string>::from(words);
+        auto copy   = filter;
+        CHECK(copy.may_contain("beta"));
+        CHECK(copy.size() == 3);
+
+        filter.clear();
+        CHECK(filter.may_contain("beta") == false);
+        CHECK(copy.may_contain("beta"));
+    }
+}
+
+//-------------------------------------
+TEST_CASE("TVector with a TBloomFilter") {
+    TVector<int> values;
+    for (int i = 0; i < 1000; ++i)
+        values.push_back(i * 2);
+
+    auto filter = TBloomFilter<int>::from(values);
+    CHECK(values.contains(998, filter));
+    CHECK(values.contains(999, filter) == false);
+    CHECK(values.get_index(4, filter) == 2);
+    CHECK(values.get_index(5, filter) == -1);
+    CHECK(values.find(6, filter) == values.cbegin() + 3);
+    CHECK(values.find(7, filter) == values.cend());
+
+    CHECK(values.push_back_if_new(7, filter));
+    CHECK(values.push_back_if_new(7, filter) == false);
+    CHECK(values.push_back_if_new(8, filter) == false);
+    CHECK(values.get_index(7, filter) == 1000);
+}
+
+//-------------------------------------
+TEST_CASE("TBloomVector") {
+    TBloomVector<int> values;
+    CHECK(values.empty());
+
+    // Growing past the capacity of the filter rebuilds it
+    for (int i = 0; i < 1000; ++i)
+        CHECK(values.push_back_if_new(i * 2));
+    CHECK(values.push_back_if_new(10) == false);
+    CHECK(values.emplace_back_if_new(11));
+    CHECK(values.size() == 1001);
+    CHECK(values.filter().capacity() >= values.size());
+
+    CHECK(values.contains(998));
+    CHECK(values.contains(999) == false);
+    CHECK(values.get_index(4) == 2);
+    CHECK(values.get_index(5) == -1);
+    CHECK(values.find(11) == values.cend() - 1);
+    CHECK(values.count(6) == 1);
+
+    CHECK(values.eraseValue(4));
+    CHECK(values.contains(4) == false);
+    CHECK(values.get_index(6) == 2);
+
+    TVector<int> released = values.release();
+    CHECK(released.size() == 1000);
+    CHECK(values.empty());
+    CHECK(values.contains(6) == false);
+
+    TBloomVector<int> fromVector(std::move(released), 0.001);
+    CHECK(fromVector.size() == 1000);
+    CHECK(fromVector.contains(6));
+    CHECK(fromVector[0] == 0);
+}
@@ -0,0 +1,173 @@
+#include <doctest.h>
+#include <concurrent_TVector.h>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace MindShake;
+
+//-------------------------------------
+// Every allocation fails
+template <class T>
+struct FailingAllocator {
+    using value_type = T;
+
+    FailingAllocator() = default;
+    template <class U>
+    FailingAllocator(const FailingAllocator<U> &) { }
+
+    T *     allocate(size_t)                                                { throw std::bad_alloc();                                       }
+    void    deallocate(T *, size_t)                                         { }
+
+    bool    operator==(const FailingAllocator &) const                      { return true;                                                  }
+    bool    operator!=(const FailingAllocator &) const                      { return false;                                                 }
+};
+
+// Its constructor throws for negative values
+struct Positive {
+    int value = 0;
+
+    Positive() = default;
+    explicit Positive(int v) : value(v) {
+        if (v < 0)
+            throw std::invalid_argument("negative");
+    }
+};
+
+//-------------------------------------
+TEST_CASE("TConcurrentVector") {
+    SUBCASE("Single thread") {
+        TConcurrentVector<int> values;
+
+        CHECK(values.empty());
+        for (int i = 0; i < 1000; ++i) {
+            CHECK(values.push_back(i) == size_t(i));
+        }
+        CHECK(values.size() == 1000);
+        CHECK(values.capacity() >= 1000);
+        CHECK(values[999] == 999);
+        CHECK(values.is_published(999));
+        CHECK(values.is_published(1000) == false);
+        CHECK_THROWS_AS(values.at(1000), std::out_of_range);
+
+        // References never move
+        const int *first = &values[0];
+        values.reserve(100000);
+        CHECK(first == &values[0]);
+
+        TVector<int> frozen = values.freeze();
+        CHECK(values.empty());
+        CHECK(frozen.size() == 1000);
+        CHECK(frozen.is_sorted());
+    }
+
+    SUBCASE("Several producers") {
+        const int               numThreads = 8;
+        const int               perThread  = 10000;
+        TConcurrentVector<int>  values;
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&values, t]() {
+                for (int i = 0; i < perThread; ++i) {
+                    size_t idx = values.push_back(t * perThread + i);
+                    // A published element can be read while others keep appending
+                    CHECK(values[idx] == t * perThread + i);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        TVector<int> frozen = values.freeze();
+        CHECK(frozen.size() == numThreads * perThread);
+        frozen.sort();
+        for (int i = 0; i < numThreads * perThread; ++i) {
+            CHECK(frozen[i] == i);
+        }
+    }
+
+    SUBCASE("Contiguous") {
+        const int               numThreads = 8;
+        const int               perThread  = 1000;
+        TConcurrentVector<int>  values(TConcurrentVector<int>::contiguous, numThreads * perThread);
+        std::vector<std::thread> threads;
+
+        CHECK(values.capacity() == numThreads * perThread);
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&values, t]() {
+                for (int i = 0; i < perThread; ++i) {
+                    size_t idx = values.push_back(t * perThread + i);
+                    CHECK(values[idx] == t * perThread + i);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        CHECK_THROWS_AS(values.push_back(-1), std::length_error);
+        CHECK_THROWS_AS(values.reserve(numThreads * perThread + 1), std::length_error);
+        CHECK(values.size() == numThreads * perThread);
+
+        // The buffer is handed off
+        const int    *first  = &values[0];
+        TVector<int> frozen  = values.freeze();
+        CHECK(frozen.data() == first);
+        CHECK(frozen.size() == numThreads * perThread);
+        frozen.sort();
+        for (int i = 0; i < numThreads * perThread; ++i) {
+            CHECK(frozen[i] == i);
+        }
+
+        // Then it grows in segments
+        CHECK(values.empty());
+        values.push_back(5);
+        CHECK(values.freeze() == TVector<int> { 5 });
+    }
+
+    SUBCASE("Contiguous with a failed constructor") {
+        TConcurrentVector<Positive> values(TConcurrentVector<Positive>::contiguous, 4);
+
+        values.emplace_back(1);
+        CHECK_THROWS_AS(values.emplace_back(-1), std::invalid_argument);
+        values.emplace_back(3);
+        CHECK(values.size() == 3);
+        CHECK(values.is_published(1) == false);
+
+        TVector<Positive> frozen = values.freeze();
+        REQUIRE(frozen.size() == 2);
+        CHECK(frozen[0].value == 1);
+        CHECK(frozen[1].value == 3);
+    }
+
+    SUBCASE("Failed allocations") {
+        // Nothing is published (nor leaked)
+        TConcurrentVector<int, FailingAllocator<int>> values;
+        CHECK_THROWS_AS(values.push_back(1), std::bad_alloc);
+        CHECK_THROWS_AS(values.reserve(100), std::bad_alloc);
+        CHECK(values.is_published(0) == false);
+        CHECK(values.capacity() == 0);
+    }
+
+    SUBCASE("Non trivial types") {
+        TConcurrentVector<std::string> strings(4);
+
+        strings.emplace_back(3, 'a');
+        strings.push_back("bb");
+        strings.push_back(std::string(64, 'c'));
+
+        std::string concat;
+        strings.for_each_published([&concat](size_t, const std::string &str) {
+            concat += str;
+        });
+        CHECK(concat == "aaabb" + std::string(64, 'c'));
+
+        TVector<std::string> frozen = strings.freeze();
+        CHECK(frozen == TVector<std::string> { "aaa", "bb", std::string(64, 'c') });
+
+        strings.push_back("reuse");
+        CHECK(strings.size() == 1);
+    }
+}
@@ -0,0 +1,38 @@
+// Includes only core_TVector.h and links TVectorInstances (see tests/CMakeLists.txt):
+// the members defined in the other headers come from the explicit instantiations.
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+#include <core_TVector.h>
+
+using namespace MindShake;
+
+//-------------------------------------
+TEST_CASE("Core header") {
+    SUBCASE("Inline members") {
+        TVector<int> ints { 5, 3, 1, 4, 2 };
+
+        ints.sort();
+        CHECK(ints == TVector<int> { 1, 2, 3, 4, 5 });
+        CHECK(ints[-1] == 5);
+        CHECK(ints.filter([](const int &v) { return v & 1; }) == TVector<int> { 1, 3, 5 });
+        CHECK(ints.reduce(0, [](int a, int b) { return a + b; }) == 15);
+    }
+
+    SUBCASE("Instantiated members") {
+        TVector<int> ints(1000);
+        for (int i = 0; i < 1000; ++i)
+            ints[i] = i;
+
+        TVector<int> a = ints, b = ints;
+        a.shuffle(ExecutionPolicy::seq, 1234);
+        b.shuffle(ExecutionPolicy::seq, 1234);
+        CHECK(a == b);
+        CHECK(a != ints);
+        a.sort();
+        CHECK(a == ints);
+
+        TVector<double> doubles(100, 1.0);
+        CHECK(doubles.sample(10).size() == 10);
+        CHECK(doubles.partial_shuffle(5).size() == 100);
+    }
+}
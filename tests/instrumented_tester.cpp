@@ -0,0 +1,257 @@
+// Built with TVECTOR_TELEMETRY and TVECTOR_TRACE defined (see tests/CMakeLists.txt)
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+#include <TVector.h>
+#include <set>
+#include <string>
+#include <thread>
+
+using namespace MindShake;
+
+//-------------------------------------
+static TVectorTelemetry::Report
+findReport(const std::string &tag) {
+    for (const auto &report : TVectorTelemetry::snapshot()) {
+        if (report.tag == tag)
+            return report;
+    }
+    return TVectorTelemetry::Report { tag, 0, 0, 0, 0, 0, 0 };
+}
+
+//-------------------------------------
+TEST_CASE("Telemetry") {
+    TVectorTelemetry::reset();
+
+    SUBCASE("Growth") {
+        TVECTOR_TELEMETRY_SCOPE("growth");
+
+        TVector<int> ints;
+        for (int i = 0; i < 1000; ++i) {
+            ints.push_back(i);
+        }
+
+        auto report = findReport("growth");
+        CHECK(report.allocations > 1);
+        CHECK(report.reallocations == report.allocations - 1);
+        CHECK(report.bytesCopied > 0);
+        CHECK(report.bytesCopied < 1000 * 2 * sizeof(int));
+        CHECK(report.peakCapacityBytes >= 1000 * sizeof(int));
+        CHECK(report.elementsShifted == 0);
+    }
+
+    SUBCASE("Reserve avoids reallocations") {
+        TVECTOR_TELEMETRY_SCOPE("reserved");
+
+        TVector<int> ints;
+        ints.reserve(1000);
+        for (int i = 0; i < 1000; ++i) {
+            ints.emplace_back(i);
+        }
+
+        auto report = findReport("reserved");
+        CHECK(report.allocations == 1);
+        CHECK(report.reallocations == 0);
+        CHECK(report.bytesCopied == 0);
+        CHECK(report.peakSlackBytes == 1000 * sizeof(int));
+    }
+
+    SUBCASE("Shifts") {
+        TVector<int> ints = { 0, 1, 2, 3, 4, 5 };
+        ints.reserve(32);
+
+        TVECTOR_TELEMETRY_SCOPE("shifts");
+        ints.insert(0, -1);                     // 6 elements shifted
+        ints.erase(1);                          // 5
+        ints.emplace(-1, 6);                    // 0 (at end)
+        ints.erase(ints.begin(), ints.begin() + 2); // 5
+        ints.erase(ints.begin(), ints.begin());     // 0 (empty range)
+        CHECK(ints == TVector<int> { 2, 3, 4, 5, 6 });
+
+        auto report = findReport("shifts");
+        CHECK(report.elementsShifted == 16);
+        CHECK(report.allocations == 0);
+    }
+
+    SUBCASE("Copies and assign") {
+        TVector<int> source(1000, 7);
+
+        TVECTOR_TELEMETRY_SCOPE("copies");
+        TVector<int> ints;
+        ints = source;                          // Allocates
+        ints.assign(2000, 1);                   // Reallocates, without copying the old elements
+        ints.assign({ 1, 2, 3 });               // Fits
+        ints = { 4, 5 };                        // Fits
+        CHECK(ints == TVector<int> { 4, 5 });
+
+        auto report = findReport("copies");
+        CHECK(report.allocations == 2);
+        CHECK(report.bytesCopied == 0);
+        CHECK(report.peakCapacityBytes >= 2000 * sizeof(int));
+    }
+
+    SUBCASE("Tags are per thread") {
+        std::thread worker([]() {
+            TVECTOR_TELEMETRY_SCOPE("worker");
+            TVector<std::string> strings(10);
+            strings.resize(100);
+        });
+        worker.join();
+
+        {
+            TVECTOR_TELEMETRY_SITE();
+            TVector<int> ints;
+            ints.resize(10);
+        }
+
+        CHECK(findReport("worker").allocations == 1);
+        CHECK(findReport("worker").bytesCopied == 10 * sizeof(std::string));
+
+        std::string json = TVectorTelemetry::to_json();
+        CHECK(json.find("\"tag\": \"worker\"") != std::string::npos);
+        CHECK(json.find("instrumented_tester.cpp:") != std::string::npos);
+    }
+}
+
+//-------------------------------------
+static size_t
+countEvents(const std::vector<TVectorTrace::Event> &events, const char *name, int policy) {
+    size_t count = 0;
+    for (const auto &event : events) {
+        if (std::string(event.name) == name && event.policy == policy)
+            ++count;
+    }
+    return count;
+}
+
+//-------------------------------------
+TEST_CASE("Trace") {
+    TVectorTrace::clear();
+
+    SUBCASE("Algorithms") {
+        TVector<int> ints(1000);
+        TVector<int> output;
+
+        std::iota(ints.begin(), ints.end(), 0);
+        ints.shuffle()
+            .sort()
+            .for_each([](int &v) { v *= 2; });
+        ints.transform(ExecutionPolicy::par, output, [](int v) { return v + 1; });
+        CHECK(ints.filter([](int v) { return v < 10; }).size() == 5);
+        CHECK(ints.reduce(ExecutionPolicy::seq, 0, [](int a, int b) { return a + b; }) == 999000);
+
+        auto events = TVectorTrace::snapshot();
+        CHECK(countEvents(events, "sort", TVectorTrace::kNoPolicy) == 1);
+        CHECK(countEvents(events, "for_each", TVectorTrace::kNoPolicy) == 1);
+        CHECK(countEvents(events, "transform", int(ExecutionPolicy::par)) == 1);
+        CHECK(countEvents(events, "filter", TVectorTrace::kNoPolicy) == 1);
+        CHECK(countEvents(events, "reduce", int(ExecutionPolicy::seq)) == 1);
+        for (const auto &event : events) {
+            CHECK(event.count == 1000);
+            CHECK(event.endNs >= event.startNs);
+        }
+
+        std::string json = TVectorTrace::to_chrome_json();
+        CHECK(json.find("\"traceEvents\"") != std::string::npos);
+        CHECK(json.find("\"name\": \"sort\", \"cat\": \"TVector\", \"ph\": \"X\"") != std::string::npos);
+        CHECK(json.find("\"policy\": \"par\"") != std::string::npos);
+    }
+
+    SUBCASE("Automatic with the cost of the operation") {
+        TVector<int> ints(1000, 1);
+        TVector<int> output;
+
+        // 1000 elements are below the default thresholds, not 1000 expensive ones
+        const int par = (detail::hardwareThreads() > 1) ? int(ExecutionPolicy::par) : int(ExecutionPolicy::seq);
+        ints.transform(ExecutionPolicy::automatic, output, [](int v) { return v + 1; });
+        ints.transform(ExecutionPolicy::automatic, output, [](int v) { return v + 1; }, 100.0);
+        ints.transform(ExecutionPolicy::automatic, output.begin(), [](int v) { return v + 1; }, 100.0);
+        ints.transform(ExecutionPolicy::automatic, output.begin(), output.begin(), [](int a, int b) { return a + b; }, 100.0);
+        CHECK(output == TVector<int>(1000, 3));
+        CHECK(ints.reduce(ExecutionPolicy::automatic, 0, std::plus<int>(), 200.0) == 1000);
+        CHECK(ints.transform_reduce(ExecutionPolicy::automatic, 0, std::plus<int>(), [](int v) { return v * 2; }, 100.0) == 2000);
+
+        // An integer cost is a cost, not the op of the binary transform
+        ints.transform(ExecutionPolicy::automatic, output.begin(), [](int v) { return v + 2; }, 100);
+        ints.transform(ExecutionPolicy::automatic, output, [](int v) { return v + 2; }, 100);
+        CHECK(output == TVector<int>(1000, 3));
+        CHECK(ints.reduce(ExecutionPolicy::automatic, 0, std::plus<int>(), 200) == 1000);
+        CHECK(ints.transform_reduce(ExecutionPolicy::automatic, 0, std::plus<int>(), [](int v) { return v * 2; }, 100) == 2000);
+
+        auto events = TVectorTrace::snapshot();
+        CHECK(countEvents(events, "transform", int(ExecutionPolicy::seq)) == ((par == int(ExecutionPolicy::seq)) ? 6 : 1));
+        if (par != int(ExecutionPolicy::seq)) {
+            CHECK(countEvents(events, "transform", par) == 5);
+        }
+        CHECK(countEvents(events, "reduce", par) == 2);
+        CHECK(countEvents(events, "transform_reduce", par) == 2);
+    }
+
+    SUBCASE("Ring buffer keeps the last events") {
+        TVector<int> ints { 3, 2, 1 };
+        for (size_t i = 0; i < 3 * TVectorTrace::kBufferSize; ++i) {
+            ints.sort();
+        }
+        CHECK(countEvents(TVectorTrace::snapshot(), "sort", TVectorTrace::kNoPolicy) == TVectorTrace::kBufferSize);
+    }
+
+    SUBCASE("One buffer per thread") {
+        std::thread worker([]() {
+            TVector<int> ints { 3, 2, 1 };
+            ints.stable_sort();
+        });
+        worker.join();
+
+        TVector<int> ints { 3, 2, 1 };
+        ints.stable_sort();
+
+        auto events = TVectorTrace::snapshot();
+        REQUIRE(countEvents(events, "stable_sort", TVectorTrace::kNoPolicy) == 2);
+        uint32_t threads[2];
+        size_t   n = 0;
+        for (const auto &event : events) {
+            if (std::string(event.name) == "stable_sort")
+                threads[n++] = event.thread;
+        }
+        CHECK(threads[0] != threads[1]);
+    }
+
+    SUBCASE("Buffers of ended threads are reused") {
+        const size_t buffers = TVectorTrace::buffer_count();
+        for (int t = 0; t < 50; ++t) {
+            std::thread worker([]() {
+                TVector<int> ints { 3, 2, 1 };
+                ints.stable_sort();
+            });
+            worker.join();
+        }
+        CHECK(TVectorTrace::buffer_count() <= buffers + 1);
+
+        // Their events are kept, each one with its own thread
+        auto                 events = TVectorTrace::snapshot();
+        std::set<uint32_t>   threads;
+        for (const auto &event : events) {
+            if (std::string(event.name) == "stable_sort")
+                threads.insert(event.thread);
+        }
+        CHECK(threads.size() == 50);
+    }
+}
+
+//-------------------------------------
+// ctest runs each test case in its own process: here the first traced call is on a pool worker, so the trace
+// registry is built after the WorkerPool and the workers give their buffers back after the statics are destroyed
+TEST_CASE("Trace first recorded on a pool worker") {
+    TVector<int> ints { 3, 2, 1 };
+    ints.sort_async().get();
+
+    std::thread worker([]() {
+        TVector<int> ints { 3, 2, 1 };
+        ints.sort();
+    });
+    worker.join();
+
+    CHECK(ints == TVector<int> { 1, 2, 3 });
+    auto events = TVectorTrace::snapshot();
+    CHECK(countEvents(events, "sort_async", TVectorTrace::kNoPolicy) == 1);
+    CHECK(countEvents(events, "sort", TVectorTrace::kNoPolicy) == 1);
+}
@@ -2,6 +2,7 @@
 #include <doctest.h>
 #include <TVector.h>
 #include <cstdio>
+#include <thread>
 
 #if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
     #include <chrono>
@@ -43,6 +44,28 @@ struct KK {
 
 int KK::count = 0;
 
+//-------------------------------------
+// Counts the elements allocated through it
+template <class T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <class U>
+    CountingAllocator(const CountingAllocator<U> &) { }
+
+    T *     allocate(size_t n)                                              { allocated += n; return std::allocator<T>().allocate(n);       }
+    void    deallocate(T *p, size_t n)                                      { std::allocator<T>().deallocate(p, n);                         }
+
+    bool    operator==(const CountingAllocator &) const                     { return true;                                                  }
+    bool    operator!=(const CountingAllocator &) const                     { return false;                                                 }
+
+    static size_t allocated;
+};
+
+template <class T>
+size_t CountingAllocator<T>::allocated = 0;
+
 //-------------------------------------
 int funcTVector(TVector<int> &v) {
     int sum = 0;
@@ -554,6 +577,749 @@ TEST_CASE_FIXTURE(Fixture, "Algorithms") {
 
     }
 
+    SUBCASE("Sort by key") {
+        // Float keys (radix): negatives, zeros and infinities
+        TVector<float> floats = { 3.5f, -1.0f, 0.0f, -0.0f, 2.0f, -INFINITY, INFINITY, -7.25f, 1e-30f, -1e-30f };
+        TVector<float> expected = floats;
+        expected.stable_sort([](const float &a, const float &b) { return a < b; });
+        floats.sort_by([](const float &v) { return v; });
+        CHECK(floats == expected);
+        CHECK(std::signbit(floats[4]));     // -0 before +0
+
+        // Stability with integer keys (radix), signed and unsigned
+        struct Item { int key; int order; };
+        TVector<Item> items;
+        Xoshiro256    g(5);
+        for (int i = 0; i < 5000; ++i)
+            items.push_back(Item { int(g() % 200) - 100, i });
+
+        TVector<Item> byKey = items;
+        byKey.stable_sort_by([](const Item &item) { return item.key; });
+        bool sorted = true;
+        for (size_t i = 1; i < byKey.size(); ++i)
+            sorted &= (byKey[i - 1].key < byKey[i].key) || (byKey[i - 1].key == byKey[i].key && byKey[i - 1].order < byKey[i].order);
+        CHECK(sorted);
+
+        byKey.sort_by([](const Item &item) { return uint64_t(item.order) * 7919 % 5000; });
+        CHECK(byKey[0].order == 0);
+
+        // Non radix keys use a comparison sort
+        TVector<std::string> words = { "pear", "fig", "banana", "kiwi", "apple" };
+        words.stable_sort_by([](const std::string &w) { return w.size(); });
+        CHECK(words == TVector<std::string> { "fig", "pear", "kiwi", "apple", "banana" });
+        words.sort_by([](const std::string &w) { return w; });
+        CHECK(words == TVector<std::string> { "apple", "banana", "fig", "kiwi", "pear" });
+
+        // Temporaries
+        CHECK(TVector<int> { 3, -1, 2 }.sort_by([](const int &v) { return -v; }) == TVector<int> { 3, 2, -1 });
+
+        // The gather buffer comes from the allocator of the vector
+        TVector<int, CountingAllocator<int>> counted = { 3, -1, 2, 7 };
+        CountingAllocator<int>::allocated = 0;
+        counted.sort_by([](const int &v) { return -v; });
+        CHECK(std::equal(counted.begin(), counted.end(), TVector<int> { 7, 3, 2, -1 }.begin()));
+        CHECK(CountingAllocator<int>::allocated == counted.size());
+    }
+
+    SUBCASE("Argsort / apply_permutation") {
+        // Integers with the default less (radix) and with another comparator, stable
+        TVector<int> keys = { 5, -3, 5, 0, -3, 9, 1 };
+        CHECK(keys.argsort() == TVector<size_t> { 1, 4, 3, 6, 0, 2, 5 });
+        CHECK(keys.argsort<uint32_t>(std::greater<int>()) == TVector<uint32_t> { 5, 0, 2, 6, 3, 1, 4 });
+        CHECK(keys.argsort(ExecutionPolicy::par) == keys.argsort());
+
+        // Parallel arrays stay in sync
+        TVector<std::string> names = { "e", "b", "f", "c", "a", "g", "d" };
+        TVector<double>      other = { 0.5, 0.1, 0.6, 0.3, 0.2, 0.7, 0.4 };
+        TVector<size_t>      order = keys.argsort();
+        keys.apply_permutation(order);
+        names.apply_permutation(order);
+        other.apply_permutation(order);
+        CHECK(keys  == TVector<int> { -3, -3, 0, 1, 5, 5, 9 });
+        CHECK(names == TVector<std::string> { "b", "a", "c", "d", "e", "f", "g" });
+        CHECK(other == TVector<double> { 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7 });
+
+        // Key functions (radix for float keys), against a copy sorted by value
+        TVector<float> floats;
+        Xoshiro256     g(11);
+        for (int i = 0; i < 1000; ++i)
+            floats.push_back(float(int(g() % 2001) - 1000) * 0.25f);
+
+        TVector<float> expected = floats;
+        expected.stable_sort();
+        CHECK(TVector<float>(floats).apply_permutation(floats.argsort_by([](const float &v) { return v; })) == expected);
+        CHECK(TVector<float>(floats).apply_permutation(floats.argsort<uint32_t>()) == expected);
+
+        // Long cycles and identity
+        TVector<int> ring = { 0, 1, 2, 3, 4, 5 };
+        CHECK(TVector<int>(ring).apply_permutation(TVector<size_t> { 1, 2, 3, 4, 5, 0 }) == TVector<int> { 1, 2, 3, 4, 5, 0 });
+        CHECK(TVector<int>(ring).apply_permutation(TVector<size_t> { 0, 1, 2, 3, 4, 5 }) == ring);
+        CHECK(TVector<int>().argsort().empty());
+        CHECK_THROWS_AS(ring.apply_permutation(TVector<size_t> { 0, 1 }), std::invalid_argument);
+        // Repeated or out of range indices, rejected before moving anything
+        CHECK_THROWS_AS(ring.apply_permutation(TVector<size_t> { 1, 1, 2, 3, 4, 5 }), std::invalid_argument);
+        CHECK_THROWS_AS(ring.apply_permutation(TVector<size_t> { 1, 2, 3, 4, 5, 6 }), std::invalid_argument);
+        CHECK_THROWS_AS(ring.apply_permutation(TVector<int> { 0, 1, 2, 3, 4, -1 }), std::invalid_argument);
+        CHECK(ring == TVector<int> { 0, 1, 2, 3, 4, 5 });
+    }
+
+    SUBCASE("Partial sort / nth_element / top_k") {
+        TVector<int> ints = { 9, 4, 7, 1, 8, 2, 6, 3, 5, 0 };
+        TVector<int> partial = TVector<int>(ints).partial_sort(3);
+        CHECK(TVector<int>(partial.begin(), partial.begin() + 3) == TVector<int> { 0, 1, 2 });
+        partial = TVector<int>(ints).partial_sort(3, std::greater<int>());
+        CHECK(TVector<int>(partial.begin(), partial.begin() + 3) == TVector<int> { 9, 8, 7 });
+        CHECK(TVector<int>(ints).partial_sort(100) == TVector<int> { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+
+        CHECK(TVector<int>(ints).nth_element(2)[2] == 2);
+        CHECK(TVector<int>(ints).nth_element(-1)[9] == 9);
+        CHECK(TVector<int>(ints).nth_element(-2, std::greater<int>())[8] == 1);
+        CHECK(TVector<int>(ints).nth_element(10) == ints);      // Out of range
+        CHECK(TVector<int>(ints).nth_element(-11) == ints);
+
+        CHECK(ints.median() == 4);                              // Lower median of an even size
+        CHECK(TVector<int> { 3, 1, 2 }.median() == 2);
+        CHECK(ints.median(std::greater<int>()) == 5);
+        CHECK(TVector<int>().median() == 0);
+        CHECK(ints == TVector<int> { 9, 4, 7, 1, 8, 2, 6, 3, 5, 0 }); // Not modified
+
+        CHECK(ints.top_k(3) == TVector<int> { 9, 8, 7 });
+        CHECK(ints.top_k(3, std::greater<int>()) == TVector<int> { 0, 1, 2 });
+        CHECK(ints.top_k(0).empty());
+        CHECK(ints.top_k(20) == TVector<int> { 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 });
+
+        // Heap (small k), selection (big k) and parallel chunks give the same result as sorting
+        TVector<uint32_t> big;
+        Xoshiro256        g(99);
+        for (int i = 0; i < 300000; ++i)
+            big.push_back(uint32_t(g() % 100000));
+
+        TVector<uint32_t> sorted = big;
+        sorted.sort(std::greater<uint32_t>());
+        for (size_t k : { size_t(1), size_t(100), size_t(50000) }) {
+            TVector<uint32_t> expected(sorted.begin(), sorted.begin() + ptrdiff_t(k));
+            CHECK(big.top_k(k) == expected);
+            CHECK(big.top_k(ExecutionPolicy::par, k) == expected);
+            CHECK(big.top_k(ExecutionPolicy::automatic, k) == expected);
+        }
+    }
+
+    SUBCASE("Set operations") {
+        TVector<int> a = { 1, 2, 2, 3, 5, 8, 13 };
+        TVector<int> b = { 2, 3, 4, 5, 6, 13, 21 };
+        CHECK(a.set_union(b)                == TVector<int> { 1, 2, 2, 3, 4, 5, 6, 8, 13, 21 });
+        CHECK(a.set_intersection(b)         == TVector<int> { 2, 3, 5, 13 });
+        CHECK(a.set_difference(b)           == TVector<int> { 1, 2, 8 });
+        CHECK(a.set_symmetric_difference(b) == TVector<int> { 1, 2, 4, 6, 8, 21 });
+        CHECK(a.intersect_count(b) == 4);
+
+        // In place, same results
+        CHECK(TVector<int>(a).set_union_with(b)                == a.set_union(b));
+        CHECK(TVector<int>(a).set_intersection_with(b)         == a.set_intersection(b));
+        CHECK(TVector<int>(a).set_difference_with(b)           == a.set_difference(b));
+        CHECK(TVector<int>(a).set_symmetric_difference_with(b) == a.set_symmetric_difference(b));
+        CHECK(TVector<int>(a).set_union_with(a) == a);
+        CHECK(a.set_difference_with(a).empty());
+
+        // Other comparators and types
+        TVector<std::string> x = { "pear", "kiwi", "fig" };
+        TVector<std::string> y = { "plum", "kiwi", "apple" };
+        CHECK(x.set_intersection(y, std::greater<std::string>()) == TVector<std::string> { "kiwi" });
+        CHECK(x.set_symmetric_difference_with(y, std::greater<std::string>()) == TVector<std::string> { "plum", "pear", "fig", "apple" });
+
+        // Skewed sizes use galloping search, in both directions
+        TVector<uint32_t> big, small;
+        for (uint32_t i = 0; i < 100000; ++i)
+            big.push_back(i * 3);
+        for (uint32_t i = 0; i < 100; ++i)
+            small.push_back(i * i * 7);
+
+        TVector<uint32_t> expected;
+        std::set_intersection(small.begin(), small.end(), big.begin(), big.end(), std::back_inserter(expected));
+        CHECK(small.set_intersection(big) == expected);
+        CHECK(big.set_intersection(small) == expected);
+        CHECK(big.intersect_count(small) == expected.size());
+        CHECK(TVector<uint32_t>(big).set_intersection_with(small) == expected);
+
+        TVector<uint32_t> difference;
+        std::set_difference(small.begin(), small.end(), big.begin(), big.end(), std::back_inserter(difference));
+        CHECK(TVector<uint32_t>(small).set_difference_with(big) == difference);
+    }
+
+    SUBCASE("K-way merge") {
+        std::vector<TVector<int>> runs = { { 1, 4, 9 }, {}, { 2, 3, 10, 11 }, { 0 }, { 4, 5 }, { 6, 7, 8 } };
+        CHECK(TVector<int>::merge_sorted(runs) == TVector<int> { 0, 1, 2, 3, 4, 4, 5, 6, 7, 8, 9, 10, 11 });
+        CHECK(TVector<int>::merge_sorted(std::vector<TVector<int>> {}).empty());
+        CHECK(TVector<int>::merge_sorted(std::vector<TVector<int>> { { 3, 1 }, { 2 } }, std::greater<int>()) == TVector<int> { 3, 2, 1 });
+        std::vector<TVector<std::string>> words = { { "b", "d" }, { "a", "d", "e" }, { "c" } };
+        CHECK(TVector<std::string>::merge_sorted(words) == TVector<std::string> { "a", "b", "c", "d", "d", "e" });
+
+        // Stable: equal keys keep the order of the runs
+        struct Item { int key; int run; };
+        auto byKey = [](const Item &a, const Item &b) { return a.key < b.key; };
+        std::vector<TVector<Item>> items(5);
+        for (int r = 0; r < 5; ++r) {
+            for (int key = 0; key < 50; key += 1 + r % 2)
+                items[r].push_back(Item { key, r });
+        }
+        TVector<Item> merged = TVector<Item>::merge_sorted(items, byKey);
+        bool stable = merged.size() == 50 * 3 + 25 * 2;
+        for (size_t i = 1; i < merged.size(); ++i)
+            stable &= (merged[i - 1].key < merged[i].key) || (merged[i - 1].key == merged[i].key && merged[i - 1].run < merged[i].run);
+        CHECK(stable);
+
+        // Many runs, sequential and parallel, against a sort
+        std::vector<TVector<uint32_t>> shards(37);
+        TVector<uint32_t>              all;
+        Xoshiro256                     g(17);
+        for (auto &shard : shards) {
+            shard.resize(size_t(g() % 20000));
+            for (auto &v : shard)
+                v = uint32_t(g() % 1000);
+            shard.sort();
+            all.insert(all.end(), shard.begin(), shard.end());
+        }
+        all.sort();
+        CHECK(TVector<uint32_t>::merge_sorted(shards) == all);
+        CHECK(TVector<uint32_t>::merge_sorted(ExecutionPolicy::par, shards) == all);
+        CHECK(TVector<uint32_t>::merge_sorted(ExecutionPolicy::automatic, shards, std::less<uint32_t>()) == all);
+    }
+
+    SUBCASE("Bounds") {
+        // Sizes around powers of two, with duplicates, against std::lower_bound / std::upper_bound
+        Xoshiro256 g(31);
+        for (size_t n : { size_t(0), size_t(1), size_t(2), size_t(3), size_t(8), size_t(9), size_t(100) }) {
+            TVector<int> sorted;
+            for (size_t i = 0; i < n; ++i)
+                sorted.push_back(int(g() % (n + 1)) * 2);
+            sorted.sort();
+
+            bool same = true;
+            for (int value = -1; value <= int(n) * 2 + 2; ++value) {
+                same &= sorted.lower_bound(value) == std::lower_bound(sorted.begin(), sorted.end(), value);
+                same &= sorted.upper_bound(value) == std::upper_bound(sorted.begin(), sorted.end(), value);
+                same &= sorted.equal_range(value) == std::equal_range(sorted.begin(), sorted.end(), value);
+                same &= sorted.binary_search(value) == std::binary_search(sorted.begin(), sorted.end(), value);
+            }
+            CHECK(same);
+        }
+
+        const TVector<int> ints = { 1, 3, 3, 3, 8 };
+        CHECK(ints.lower_bound(3) - ints.cbegin() == 1);
+        CHECK(ints.upper_bound(3) - ints.cbegin() == 4);
+        CHECK(ints.equal_range(4).first == ints.equal_range(4).second);
+
+        // Equality uses the comparator: 6 is not in { 5, 4 } sorted by std::greater
+        TVector<int> descending = { 5, 4 };
+        CHECK(descending.binary_search_it(6, std::greater<int>()) == descending.cend());
+        CHECK(descending.binary_search_it(6, TVector<int>::FuncLess(std::greater<int>())) == descending.cend());
+        CHECK(descending.binary_search(6, std::greater<int>()) == false);
+        CHECK(descending.binary_search_it(4, std::greater<int>()) == descending.cbegin() + 1);
+        *descending.lower_bound(5, std::greater<int>()) = 7;
+        CHECK(descending == TVector<int> { 7, 4 });
+    }
+
+    SUBCASE("Search index") {
+        // Sizes around the block sizes, with duplicates, against std::lower_bound / std::upper_bound
+        Xoshiro256 g(23);
+        for (size_t n : { size_t(0), size_t(1), size_t(15), size_t(16), size_t(17), size_t(256), size_t(257), size_t(5000) }) {
+            TVector<int> sorted;
+            for (size_t i = 0; i < n; ++i)
+                sorted.push_back(int(g() % (n + 1)) * 2);
+            sorted.sort();
+
+            auto index = sorted.build_search_index();
+            CHECK(index.size() == n);
+            bool same = true;
+            for (int value = -1; value <= int(n) * 2 + 2; ++value) {
+                same &= index.lower_bound(value) == size_t(std::lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin());
+                same &= index.upper_bound(value) == size_t(std::upper_bound(sorted.begin(), sorted.end(), value) - sorted.begin());
+                same &= index.contains(value) == sorted.binary_search(value);
+            }
+            CHECK(same);
+
+            // Batched: more queries than a batch, and misses at both ends
+            std::vector<int>    queries;
+            for (int value = -1; value <= int(n) * 2 + 2; ++value)
+                queries.push_back(value);
+            std::vector<size_t> positions(queries.size());
+            index.lower_bound_many(queries, positions.begin());
+            for (size_t q = 0; q < queries.size(); ++q)
+                same &= positions[q] == index.lower_bound(queries[q]);
+            CHECK(same);
+        }
+
+        TVector<int> ints = { 1, 3, 3, 3, 8 };
+        auto         index = ints.build_search_index();
+        CHECK(index.find(3) == 1);
+        CHECK(index.find(4) == decltype(index)::npos);
+        CHECK(index.equal_range(3) == std::make_pair(size_t(1), size_t(4)));
+
+        // Other types and comparators (doubles use blocks of 8)
+        TVector<double> descending;
+        for (int i = 1000; i > 0; --i)
+            descending.push_back(i * 0.5);
+        auto byGreater = descending.build_search_index(std::greater<double>());
+        CHECK(byGreater.levels() == 3);
+        CHECK(byGreater.lower_bound(250.0) == 500);
+        CHECK(byGreater.upper_bound(250.0) == 501);
+        CHECK(byGreater.lower_bound(1000.0) == 0);
+        CHECK(byGreater.lower_bound(0.0) == 1000);
+
+        // 1 and 2 byte elements (a cache line holds several blocks) at every offset in the line,
+        // with 0xFF before the data to catch reads before it
+        auto smallTypes = [](auto zero) {
+            using Small = decltype(zero);
+            TVector<Small> sorted;
+            for (size_t i = 0; i < 1000; ++i)
+                sorted.push_back(Small(i / 8));
+            std::vector<uint8_t> buffer((64 + sorted.size()) * sizeof(Small) + 64, 0xFF);
+            uint8_t *line = buffer.data() + (64 - size_t(reinterpret_cast<uintptr_t>(buffer.data())) % 64);
+            bool same = true;
+            for (size_t offset = 0; offset < 64; offset += sizeof(Small)) {
+                Small *data = reinterpret_cast<Small *>(line + offset);
+                std::fill(buffer.begin(), buffer.end(), uint8_t(0xFF));
+                std::copy(sorted.begin(), sorted.end(), data);
+                TSearchIndex<Small, std::less<Small>> index(data, sorted.size());
+                for (int value = 0; value <= 130; ++value) {
+                    same &= index.lower_bound(Small(value)) == size_t(std::lower_bound(sorted.begin(), sorted.end(), Small(value)) - sorted.begin());
+                    same &= index.upper_bound(Small(value)) == size_t(std::upper_bound(sorted.begin(), sorted.end(), Small(value)) - sorted.begin());
+                }
+            }
+            return same;
+        };
+        CHECK(smallTypes(uint8_t(0)));
+        CHECK(smallTypes(uint16_t(0)));
+
+        TVector<uint16_t> shorts(1000);
+        std::iota(shorts.begin(), shorts.end(), uint16_t(0));
+        auto byShort = shorts.build_search_index();
+        CHECK(byShort.lower_bound(uint16_t(517)) == 517);
+        CHECK(byShort.upper_bound(uint16_t(999)) == 1000);
+    }
+
+    SUBCASE("Batched search") {
+        // Sizes around the batch size, with duplicates and misses, against std::lower_bound
+        Xoshiro256 g(29);
+        for (size_t n : { size_t(0), size_t(1), size_t(2), size_t(17), size_t(1000) }) {
+            TVector<int> sorted;
+            for (size_t i = 0; i < n; ++i)
+                sorted.push_back(int(g() % (n + 1)) * 2);
+            sorted.sort();
+
+            TVector<int> queries;
+            for (int value = -1; value <= int(n) * 2 + 2; ++value)
+                queries.push_back(value);
+            queries.shuffle(g);
+
+            std::vector<size_t> positions(queries.size());
+            std::vector<bool>   found(queries.size());
+            sorted.lower_bound_many(queries, positions.begin());
+            sorted.binary_search_many(queries, found.begin());
+
+            bool same = true;
+            for (size_t i = 0; i < queries.size(); ++i) {
+                same &= positions[i] == size_t(std::lower_bound(sorted.begin(), sorted.end(), queries[i]) - sorted.begin());
+                same &= found[i] == sorted.binary_search(queries[i]);
+            }
+            CHECK(same);
+
+            std::vector<size_t> parallel(queries.size());
+            sorted.lower_bound_many(ExecutionPolicy::par, queries, parallel.data());
+            CHECK(parallel == positions);
+
+            // Not std::vector<bool>: its bits share a word between threads
+            std::vector<char> parallelFound(queries.size());
+            sorted.binary_search_many(ExecutionPolicy::par, queries, parallelFound.begin());
+            CHECK(std::equal(parallelFound.begin(), parallelFound.end(), found.begin(), [](char a, bool b) { return bool(a) == b; }));
+        }
+
+        TVector<double> descending = { 5.0, 4.0, 4.0, 1.0 };
+        double          results[3];
+        descending.lower_bound_many(TVector<double> { 4.0, 0.0, 9.0 }, results, std::greater<double>());
+        CHECK(results[0] == 1);
+        CHECK(results[1] == 4);
+        CHECK(results[2] == 0);
+    }
+
+    SUBCASE("Group by") {
+        struct Sale { std::string city; int amount; };
+        TVector<Sale> sales = { { "Rome", 10 }, { "Oslo", 5 }, { "Rome", 7 }, { "Lima", 1 }, { "Oslo", 2 }, { "Rome", 3 } };
+        auto city = [](const Sale &sale) { return sale.city; };
+
+        // Groups in order of first appearance
+        auto counts = sales.count_by(city);
+        CHECK(counts == TVector<std::pair<std::string, size_t>> { { "Rome", 3 }, { "Oslo", 2 }, { "Lima", 1 } });
+
+        auto totals = sales.aggregate_by(city, 0, [](int total, const Sale &sale) { return total + sale.amount; });
+        CHECK(totals == TVector<std::pair<std::string, int>> { { "Rome", 20 }, { "Oslo", 7 }, { "Lima", 1 } });
+
+        auto groups = sales.group_by(city);
+        CHECK(groups.size() == 3);
+        CHECK(groups.keys == TVector<std::string> { "Rome", "Oslo", "Lima" });
+        CHECK(groups.offsets == TVector<size_t> { 0, 3, 5, 6 });
+        CHECK(groups.group_size(1) == 2);
+        CHECK(groups.group_begin(0)[1].amount == 7);       // Order kept inside a group
+        CHECK(groups.group_end(2) == groups.items.data() + groups.items.size());
+
+        TVector<int> none;
+        CHECK(none.count_by([](int v) { return v; }).empty());
+        CHECK(none.group_by([](int v) { return v; }).offsets == TVector<size_t> { 0 });
+
+        // Many keys (rehashes) and the parallel variants against the sequential ones
+        TVector<uint32_t> values(200000);
+        Xoshiro256        g(37);
+        for (auto &value : values)
+            value = uint32_t(g() % 5000);
+        auto key = [](uint32_t v) { return v % 1000; };
+
+        auto histogram = values.count_by(key);
+        CHECK(histogram.size() == 1000);
+        size_t total = 0;
+        for (const auto &bucket : histogram)
+            total += bucket.second;
+        CHECK(total == values.size());
+        CHECK(histogram[0].first == key(values[0]));
+
+        CHECK(values.count_by(ExecutionPolicy::par, key) == histogram);
+        auto maxOp = [](uint32_t m, uint32_t v) { return std::max(m, v); };
+        CHECK(values.aggregate_by(ExecutionPolicy::par, key, 0u, maxOp, maxOp) == values.aggregate_by(key, 0u, maxOp));
+
+        auto byKey = values.group_by(key);
+        bool same = byKey.size() == histogram.size();
+        for (size_t k = 0; k < byKey.size() && same; ++k) {
+            same &= byKey.keys[k] == histogram[k].first && byKey.group_size(k) == histogram[k].second;
+            for (const uint32_t *v = byKey.group_begin(k); v != byKey.group_end(k); ++v)
+                same &= key(*v) == byKey.keys[k];
+        }
+        CHECK(same);
+    }
+
+    SUBCASE("Scans") {
+        TVector<int> values = { 3, 1, 4, 1, 5 };
+        CHECK(TVector<int>(values).inclusive_scan() == TVector<int> { 3, 4, 8, 9, 14 });
+        CHECK(TVector<int>(values).inclusive_scan(std::multiplies<int>()) == TVector<int> { 3, 3, 12, 12, 60 });
+        CHECK(TVector<int>(values).exclusive_scan(10) == TVector<int> { 10, 13, 14, 18, 19 });
+        CHECK(TVector<int>(values).transform_inclusive_scan(std::plus<int>(), [](int v) { return v * v; }) == TVector<int> { 9, 10, 26, 27, 52 });
+
+        // Float sums go 4 at a time with a policy (the values are exact in binary, so any grouping gives the same sums)
+        TVector<double> reals = { 0.5, 1, 2, 3, 4, 5, 6 };
+        CHECK(TVector<double>(reals).inclusive_scan() == TVector<double> { 0.5, 1.5, 3.5, 6.5, 10.5, 15.5, 21.5 });
+        CHECK(TVector<double>(reals).inclusive_scan(ExecutionPolicy::unseq) == TVector<double> { 0.5, 1.5, 3.5, 6.5, 10.5, 15.5, 21.5 });
+
+        // Rounded sums: in place and to an output give the same values (left to right, or blocks with a policy)
+        TVector<float> floats(1000);
+        for (size_t i = 0; i < floats.size(); ++i)
+            floats[i] = float(i % 7) * 0.1f + 0.0123f;
+        TVector<float> floatsOut(floats.size());
+        floats.inclusive_scan(floatsOut.begin());
+        CHECK(TVector<float>(floats).inclusive_scan() == floatsOut);
+        floats.inclusive_scan(ExecutionPolicy::unseq, floatsOut.begin());
+        CHECK(TVector<float>(floats).inclusive_scan(ExecutionPolicy::unseq) == floatsOut);
+        floats.inclusive_scan(ExecutionPolicy::seq, floatsOut.begin());
+        CHECK(TVector<float>(floats).inclusive_scan() == floatsOut);
+
+        // To an output (of another type)
+        TVector<double> out(values.size());
+        values.exclusive_scan(out.begin(), 0.5, std::plus<double>());
+        CHECK(out == TVector<double> { 0.5, 3.5, 4.5, 8.5, 9.5 });
+        TVector<int> ints(values.size());
+        values.inclusive_scan(ints.begin());                    // std::plus by default
+        CHECK(ints == TVector<int> { 3, 4, 8, 9, 14 });
+        values.exclusive_scan(ints.data(), 1);
+        CHECK(ints == TVector<int> { 1, 4, 5, 9, 10 });
+        values.inclusive_scan(ExecutionPolicy::par, ints.begin());
+        CHECK(ints == TVector<int> { 3, 4, 8, 9, 14 });
+        std::vector<std::string> words(values.size());
+        values.transform_inclusive_scan(words.begin(), std::plus<std::string>(), [](int v) { return std::to_string(v); });
+        CHECK(words.back() == "31415");
+
+        TVector<int> none;
+        CHECK(none.inclusive_scan().empty());
+        CHECK(none.exclusive_scan(ExecutionPolicy::par, 1).empty());
+
+        // Longer than a block of the arithmetic kernel, and the parallel variants against the sequential ones
+        TVector<int64_t> large(300001);
+        Xoshiro256       g(41);
+        for (auto &value : large)
+            value = int64_t(g() % 1000);
+        TVector<int64_t> expected(large.size());
+        std::partial_sum(large.begin(), large.end(), expected.begin());
+
+        CHECK(TVector<int64_t>(large).inclusive_scan() == expected);
+        CHECK(TVector<int64_t>(large).inclusive_scan(ExecutionPolicy::par) == expected);
+        auto plus = [](int64_t a, int64_t b) { return a + b; };
+        CHECK(TVector<int64_t>(large).inclusive_scan(ExecutionPolicy::par, plus) == expected);
+
+        TVector<int64_t> scanned(large.size());
+        large.inclusive_scan(ExecutionPolicy::par, scanned.begin(), plus);
+        CHECK(scanned == expected);
+        large.exclusive_scan(ExecutionPolicy::par, scanned.data(), int64_t(7), plus);
+        CHECK(scanned[0] == 7);
+        CHECK(scanned.back() == expected[expected.size() - 2] + 7);
+        CHECK(TVector<int64_t>(large).exclusive_scan(ExecutionPolicy::par, 7) == scanned);
+
+        TVector<double> largeReals(large.begin(), large.end());
+        CHECK(largeReals.inclusive_scan(ExecutionPolicy::par).back() == double(expected.back()));
+
+        auto twice = [](int64_t v) { return v * 2; };
+        TVector<int64_t> doubled = TVector<int64_t>(large).transform_inclusive_scan(ExecutionPolicy::par, plus, twice);
+        CHECK(doubled.back() == expected.back() * 2);
+        CHECK(doubled == TVector<int64_t>(large).transform_inclusive_scan(plus, twice));
+    }
+
+    SUBCASE("Partition") {
+        TVector<int> values = { 5, 2, 8, 1, 4, 7, 6, 3 };
+        auto even = [](int v) { return v % 2 == 0; };
+
+        TVector<int> unstable = values;
+        CHECK(unstable.partition(even) == 4);
+        CHECK(std::is_partitioned(unstable.begin(), unstable.end(), even));
+
+        TVector<int> stable = values;
+        CHECK(stable.stable_partition(even) == 4);
+        CHECK(stable == TVector<int> { 2, 8, 4, 6, 5, 1, 7, 3 });
+
+        TVector<int> evens(values.size()), odds(values.size());
+        CHECK(values.partition_copy(evens.begin(), odds.begin(), even) == 4);
+        evens.resize(4);
+        odds.resize(4);
+        CHECK(evens == TVector<int> { 2, 8, 4, 6 });
+        CHECK(odds == TVector<int> { 5, 1, 7, 3 });
+
+        TVector<int> none;
+        CHECK(none.partition(ExecutionPolicy::par, even) == 0);
+        CHECK(none.stable_partition(ExecutionPolicy::par, even) == 0);
+
+        // The parallel variants against the sequential ones (unique values: the parts are compared sorted)
+        TVector<uint32_t> large(300001);
+        std::iota(large.begin(), large.end(), 0);
+        large.shuffle(Xoshiro256(43));
+        auto small = [](uint32_t v) { return v % 3 == 0 || v < 1000; };
+
+        TVector<uint32_t> expected = large;
+        const size_t      split    = expected.stable_partition(small);
+
+        TVector<uint32_t> parallel = large;
+        CHECK(parallel.partition(ExecutionPolicy::par, small) == split);
+        CHECK(std::is_partitioned(parallel.begin(), parallel.end(), small));
+        CHECK(TVector<uint32_t>(parallel.begin(), parallel.begin() + split).sort() == TVector<uint32_t>(expected.begin(), expected.begin() + split).sort());
+
+        TVector<uint32_t> stableParallel = large;
+        CHECK(stableParallel.stable_partition(ExecutionPolicy::par, small) == split);
+        CHECK(stableParallel == expected);
+
+        // The scratch buffer of the parallel stable_partition comes from the allocator of the vector
+        TVector<uint32_t, CountingAllocator<uint32_t>> counted(large.begin(), large.end());
+        CountingAllocator<uint32_t>::allocated = 0;
+        CHECK(counted.stable_partition(ExecutionPolicy::par, small) == split);
+        CHECK(std::equal(counted.begin(), counted.end(), expected.begin()));
+        if (std::min(detail::hardwareThreads(), counted.size() / detail::kMinParallelGrain) > 1) {
+            CHECK(CountingAllocator<uint32_t>::allocated == counted.size());
+        }
+
+        TVector<std::string> words = { "b", "aa", "c", "dd", "e" };
+        CHECK(words.stable_partition(ExecutionPolicy::par, [](const std::string &w) { return w.size() == 2; }) == 2);
+        CHECK(words == TVector<std::string> { "aa", "dd", "b", "c", "e" });
+
+        TVector<uint32_t> trues(large.size()), falses(large.size());
+        CHECK(large.partition_copy(ExecutionPolicy::par, trues.begin(), falses.data(), small) == split);
+        CHECK(std::equal(trues.begin(), trues.begin() + split, expected.begin()));
+        CHECK(std::equal(falses.begin(), falses.end() - split, expected.begin() + split));
+    }
+
+    SUBCASE("Parallel for_each") {
+        TVector<int> values(10000);
+        values.for_each_indexed([](size_t i, int &v) { v = int(i); });
+        CHECK(values[9999] == 9999);
+
+        // Small grains make many chunks; every element is visited once
+        std::atomic<int64_t> sum { 0 };
+        values.for_each(ExecutionPolicy::par, [&sum](const int &v) { sum += v; }, 7);
+        CHECK(sum == int64_t(9999) * 10000 / 2);
+
+        values.for_each(ExecutionPolicy::par, [](int &v) { v *= 2; }, 100);
+        values.for_each_indexed(ExecutionPolicy::par, [](size_t i, int &v) { v -= int(i); }, 33);
+        CHECK(values == TVector<int>(values).for_each_indexed([](size_t i, int &v) { v = int(i); }));
+
+        std::atomic<size_t> numChunks { 0 }, visited { 0 };
+        std::atomic<bool>   aligned { true };
+        const TVector<int> &constValues = values;
+        constValues.for_each_chunk(ExecutionPolicy::par, [&](const int *first, const int *last, size_t index) {
+            aligned   = aligned && first == constValues.data() + index && size_t(last - first) <= 1000;
+            visited  += size_t(last - first);
+            numChunks += 1;
+        }, 1000);
+        CHECK(aligned);
+        CHECK(visited == values.size());
+        CHECK(numChunks >= 1);
+
+        // The sequential policy is one chunk
+        numChunks = 0;
+        values.for_each_chunk(ExecutionPolicy::seq, [&](int *, int *, size_t) { numChunks += 1; }, 10);
+        CHECK(numChunks == 1);
+        TVector<int> none;
+        none.for_each_chunk(ExecutionPolicy::par, [&](int *, int *, size_t) { numChunks += 1; });
+        CHECK(numChunks == 1);
+    }
+
+    SUBCASE("Cancellation") {
+        TVector<int> values(300000);
+        std::iota(values.begin(), values.end(), 0);
+        values.shuffle(Xoshiro256(47));
+
+        // Not cancelled: the same results as the other overloads
+        TCancellationToken token;
+        TVector<int>       doubled(values.size());
+        CHECK(values.transform(ExecutionPolicy::par, doubled.begin(), [](int v) { return v * 2; }, token));
+        CHECK(doubled[7] == values[7] * 2);
+
+        auto sum = values.reduce(ExecutionPolicy::par, int64_t(5), [](int64_t a, int64_t b) { return a + b; }, token);
+        CHECK(sum.completed);
+        CHECK(sum.value == int64_t(299999) * 300000 / 2 + 5);
+        auto squares = values.transform_reduce(ExecutionPolicy::seq, 0.0, std::plus<double>(), [](int v) { return double(v) * v; }, token);
+        CHECK(squares);
+        CHECK(squares.value == doctest::Approx(299999.0 * 300000.0 * 599999.0 / 6.0));
+
+        auto odd      = [](int v) { return v % 2 != 0; };
+        auto filtered = values.filter(ExecutionPolicy::par, odd, token);
+        CHECK(filtered);
+        CHECK(filtered.value == values.filter(odd));
+
+        TVector<int> sorted = values;
+        CHECK(sorted.sort(ExecutionPolicy::par, token));
+        CHECK(std::is_sorted(sorted.begin(), sorted.end()));
+        CHECK(sorted.sort(ExecutionPolicy::seq, std::greater<int>(), token));
+        CHECK(sorted.front() == 299999);
+
+        // Cancelled before starting: no unit runs
+        TCancellationToken cancelled;
+        cancelled.cancel();
+        TVector<int> untouched(values.size(), -1);
+        CHECK(values.transform(ExecutionPolicy::par, untouched.data(), [](int v) { return v; }, cancelled) == false);
+        CHECK(untouched.count(-1) == untouched.size());
+        CHECK(values.reduce(ExecutionPolicy::seq, 0, std::plus<int>(), cancelled).completed == false);
+        CHECK(values.filter(ExecutionPolicy::par, odd, cancelled).completed == false);
+
+        // Cancelled in the middle (by the operation itself): the units after it are skipped
+        TCancellationToken stop;
+        std::atomic<int>   calls { 0 };
+        auto               partial = values.reduce(ExecutionPolicy::seq, int64_t(0), [&](int64_t a, int64_t b) {
+            if (++calls == 100000)
+                stop.cancel();
+            return a + b;
+        }, stop);
+        CHECK(partial.completed == false);
+        CHECK(calls < int(values.size()));
+
+        TVector<int> shuffled = values;
+        CHECK(shuffled.sort(ExecutionPolicy::par, TCancellationToken::after(std::chrono::seconds(-1))) == false);
+        CHECK(TVector<int>(shuffled).sort() == TVector<int>(values).sort());   // Still a permutation
+
+        // Deadlines
+        auto later = TCancellationToken::after(std::chrono::hours(1));
+        CHECK(later.is_cancelled() == false);
+        CHECK(later.deadline() > TCancellationToken::clock::now());
+        TCancellationToken copy = later;
+        copy.cancel();
+        CHECK(later.is_cancelled());
+        CHECK(TCancellationToken(TCancellationToken::clock::now()).is_cancelled());
+    }
+
+    SUBCASE("Shuffle / sample") {
+        TVector<int> ints(100);
+        std::iota(ints.begin(), ints.end(), 0);
+
+        // Same seed, same permutation
+        TVector<int> a = ints, b = ints;
+        a.shuffle(Xoshiro256(42));
+        b.shuffle(Xoshiro256(42));
+        CHECK(a == b);
+        CHECK(a != ints);
+        CHECK(a.sort() == ints);
+
+        // Other engines
+        std::mt19937 mt(7);
+        a.shuffle(mt);
+        CHECK(a.sort() == ints);
+
+        // Every permutation of 3 elements is equally likely
+        Xoshiro256 g(1234);
+        int        counts[6] = {};
+        for (int i = 0; i < 6000; ++i) {
+            TVector<int> perm { 0, 1, 2 };
+            perm.shuffle(g);
+            ++counts[perm[0] * 2 + (perm[1] > perm[2] ? 1 : 0)];
+        }
+        for (int count : counts) {
+            CHECK(count > 850);
+            CHECK(count < 1150);
+        }
+
+        // partial_shuffle only shuffles the first k elements
+        a = ints;
+        a.partial_shuffle(10, g);
+        CHECK(a.sort() == ints);
+
+        // sample (sparse and dense paths)
+        for (size_t k : { size_t(5), size_t(50), size_t(100), size_t(200) }) {
+            TVector<int> s = ints.sample(k, g);
+            CHECK(s.size() == std::min(k, ints.size()));
+            s.sort();
+            CHECK(std::adjacent_find(s.begin(), s.end()) == s.end());
+            CHECK(s.all_of([](int v) { return v >= 0 && v < 100; }));
+        }
+        CHECK(ints.sample(3).size() == 3);
+        CHECK(TVector<int>().sample(3).empty());
+
+        // Parallel shuffle: same seed and threads, same permutation
+        TVector<int> big(200000);
+        std::iota(big.begin(), big.end(), 0);
+        a = big;
+        b = big;
+        a.shuffle(ExecutionPolicy::par, 99, 4);
+        b.shuffle(ExecutionPolicy::par, 99, 4);
+        CHECK(a == b);
+        CHECK(a != big);
+        CHECK(a.sort() == big);
+        b.shuffle(ExecutionPolicy::seq, 99);
+        CHECK(b.sort() == big);
+
+        // MergeShuffle is unbiased, even with blocks of different sizes
+        for (size_t numBlocks : { size_t(3), size_t(4) }) {
+            int perms[24] = {};
+            for (uint64_t seed = 0; seed < 24000; ++seed) {
+                int values[4] = { 0, 1, 2, 3 };
+                mergeShuffle(values, values + 4, seed, numBlocks, 1);
+                int rank = 0;
+                for (int i = 0; i < 4; ++i) {
+                    int smaller = 0;
+                    for (int j = i + 1; j < 4; ++j)
+                        smaller += values[j] < values[i];
+                    rank = rank * (4 - i) + smaller;
+                }
+                ++perms[rank];
+            }
+            for (int count : perms) {
+                CHECK(count > 850);
+                CHECK(count < 1150);
+            }
+        }
+
+        // Concurrent shuffles use one engine per thread
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&ints]() {
+                TVector<int> local = ints;
+                for (int i = 0; i < 100; ++i)
+                    local.shuffle();
+                CHECK(local.sort() == ints);
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+    }
+
     SUBCASE("Rotate") {
         TVector<int> ints = { 0, 1, 2, 3, 4, 5 };
         ints.rotate(2);
@@ -638,6 +1404,118 @@ TEST_CASE_FIXTURE(Fixture, "Algorithms") {
 //#endif
         }
 
+        SUBCASE("Move / rvalue chains") {
+            // Moving from std::vector keeps the buffer
+            std::vector<int> plain { 5, 1, 4, 1, 3 };
+            const int        *buffer = plain.data();
+            TVector<int>     moved(std::move(plain));
+            CHECK(moved.data() == buffer);
+
+            std::vector<int> std2 { 7, 8 };
+            buffer = std2.data();
+            TVector<int> assigned;
+            assigned = std::move(std2);
+            CHECK(assigned.data() == buffer);
+            static_assert(std::is_same<decltype(assigned = std::vector<int> {}), TVector<int> &>::value, "operator= returns TVector &");
+
+            // Chains on temporaries reuse the same storage
+            TVector<int> values { 5, 1, 4, 1, 3, 2, 5, 8 };
+            buffer = values.data();
+            TVector<int> result = std::move(values)
+                                    .filter([](const int &v) { return v < 8; })
+                                    .sort()
+                                    .unique()
+                                    .transform([](const int &v) { return v * 10; })
+                                    .replace(30, 33)
+                                    .replace_if([](const int &v) { return v > 40; }, 0)
+                                    .reverse();
+            CHECK(result.data() == buffer);
+            CHECK(result == TVector<int> { 0, 40, 33, 20, 10 });
+
+            // Lvalues are not modified by filter
+            TVector<int> source { 1, 2, 3, 4 };
+            TVector<int> even = source.filter([](const int &v) { return (v & 1) == 0; });
+            CHECK(source.size() == 4);
+            CHECK(even == TVector<int> { 2, 4 });
+            CHECK(source.transform([](const int &v) { return v + 1; }) == TVector<int> { 2, 3, 4, 5 });
+        }
+
+        SUBCASE("Automatic policy") {
+            ExecutionThresholds thresholds;
+            thresholds.transform        = 1000;
+            thresholds.reduce           = 2000;
+            thresholds.transform_reduce = 3000;
+
+            const ExecutionPolicy par = (detail::hardwareThreads() > 1) ? ExecutionPolicy::par : ExecutionPolicy::seq;
+            CHECK(resolvePolicy(ExecutionPolicy::automatic, PolicyOperation::transform, 999, 1.0, thresholds) == ExecutionPolicy::seq);
+            CHECK(resolvePolicy(ExecutionPolicy::automatic, PolicyOperation::transform, 1000, 1.0, thresholds) == par);
+            CHECK(resolvePolicy(ExecutionPolicy::automatic, PolicyOperation::reduce, 1000, 1.0, thresholds) == ExecutionPolicy::seq);
+            CHECK(resolvePolicy(ExecutionPolicy::automatic, PolicyOperation::reduce, 1000, 2.0, thresholds) == par);
+            CHECK(resolvePolicy(ExecutionPolicy::automatic, PolicyOperation::transform_reduce, 2999, 1.0, thresholds) == ExecutionPolicy::seq);
+            CHECK(resolvePolicy(ExecutionPolicy::par_unseq, PolicyOperation::transform, 1, 1.0, thresholds) == ExecutionPolicy::par_unseq);
+
+            // Save / load
+            const char *path = "tvector_thresholds_test.cfg";
+            REQUIRE(thresholds.save(path));
+            ExecutionThresholds loaded;
+            REQUIRE(loaded.load(path));
+            CHECK(loaded.transform == 1000);
+            CHECK(loaded.reduce == 2000);
+            CHECK(loaded.transform_reduce == 3000);
+            remove(path);
+            CHECK(loaded.load(path) == false);
+
+            // Same results with any policy
+            TVector<int> ints(300000);
+            std::iota(ints.begin(), ints.end(), 0);
+            TVector<int> output;
+            ints.transform(ExecutionPolicy::automatic, output, [](int v) { return v & 7; });
+            CHECK(output.reduce(ExecutionPolicy::automatic, 0, std::plus<int>()) == output.reduce(0, std::plus<int>()));
+            CHECK(ints.transform_reduce(ExecutionPolicy::automatic, size_t(0), std::plus<size_t>(), [](int v) { return size_t(v & 1); }) == 150000);
+
+            // With the cost of the operation
+            TVector<int> costly;
+            ints.transform(ExecutionPolicy::automatic, costly, [](int v) { return v & 7; }, 16.0);
+            CHECK(costly == output);
+            CHECK(output.reduce(ExecutionPolicy::automatic, 0, std::plus<int>(), 16.0) == output.reduce(0, std::plus<int>()));
+            CHECK(ints.transform_reduce(ExecutionPolicy::automatic, size_t(0), std::plus<size_t>(), [](int v) { return size_t(v & 1); }, 16.0) == 150000);
+        }
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+        SUBCASE("Compile-time policy") {
+            TVector<int> ints(10000);
+            std::iota(ints.begin(), ints.end(), 0);
+            const int expected = ints.reduce(0, std::plus<int>());
+
+            CHECK(ints.reduce(execution::seq, 0, std::plus<int>()) == expected);
+            CHECK(ints.reduce(execution::par, 0, std::plus<int>()) == expected);
+            CHECK(ints.reduce(execution::par_unseq, 0, std::plus<int>()) == expected);
+            CHECK(ints.reduce(execution::unseq, 0, std::plus<int>()) == expected);
+            CHECK(ints.reduce(execution::automatic, 0, std::plus<int>()) == expected);
+            CHECK(ints.transform_reduce(execution::par, 0, std::plus<int>(), [](int v) { return v & 1; }) == 5000);
+            CHECK(ints.transform_reduce(execution::automatic, 0, std::plus<int>(), [](int v) { return v & 1; }) == 5000);
+
+            TVector<int> output;
+            ints.transform(execution::par, output, [](int v) { return v * 2; });
+            CHECK(output.size() == ints.size());
+            CHECK(output[9999] == 19998);
+
+            TVector<int> output2(ints.size());
+            ints.transform(execution::seq, output2.begin(), [](int v) { return v * 2; });
+            CHECK(output2 == output);
+
+            ints.transform(execution::automatic, output.begin(), output2.begin(), [](int a, int b) { return b - a; });
+            CHECK(output2 == ints);
+
+            const TVector<int> &cints = ints;
+            cints.transform(execution::unseq, output2, [](int v) { return -v; });
+            CHECK(output2[10] == -10);
+
+            static_assert(execution::is_policy_tag<execution::par_t>::value, "par_t is a policy tag");
+            static_assert(execution::is_policy_tag<ExecutionPolicy>::value == false, "ExecutionPolicy is not a tag");
+        }
+#endif
+
 #if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
         SUBCASE("Accumulate/Reduce time") {
             std::random_device   rd;
@@ -678,4 +1556,4 @@ TEST_CASE_FIXTURE(Fixture, "Algorithms") {
         }
 #endif
     }
-}
\ No newline at end of file
+}
\ No newline at end of file